@@ -13,43 +13,67 @@ namespace Budgie {
 	/**
 	* This holds all of the application and category state for all
 	* installed applications on the system.
+	*
+	* The state is kept in an immutable snapshot. Refreshes build a new
+	* snapshot on a worker thread, and the main loop swaps it in once it
+	* is ready, so consumers keep serving the old snapshot until then.
 	*/
 	public class AppIndex : Object {
 		private static AppIndex _instance;
 
 		/**
-		 * List of all categories with apps in them.
+		 * The currently published state of the index.
+		 *
+		 * This is only replaced from the main thread, and is never modified
+		 * after it has been published.
 		 */
-		private Gee.ArrayList<Category> categories;
-		private Category misc_category;
+		private AppIndexSnapshot snapshot;
 
 		private AppInfoMonitor monitor;
 		private FileMonitor file_monitor;
 		private uint timeout_id = 0;
 
+		private AppIndexCache cache;
+
+		/* Whether the next refresh has to rebuild the categories */
+		private bool rebuild_pending = true;
+
+		/* Whether a refresh is currently running on a worker thread */
+		private bool refreshing = false;
+
+		/* Whether another refresh was requested while one was running */
+		private bool refresh_queued = false;
+
 		/**
 		* Signal emitted whenever a change to the application state
 		* occurs.
 		*/
 		public signal void changed();
 
+		/**
+		 * Signal emitted with the applications that were added, removed,
+		 * or updated by a refresh of the index.
+		 *
+		 * This is emitted right before `changed()`, and only when at least
+		 * one application actually changed.
+		 */
+		public signal void apps_changed(Gee.List<Application> added, Gee.List<Application> removed, Gee.List<Application> updated);
+
 		private AppIndex() {
 			Object();
 		}
 
 		construct {
-			this.categories = new Gee.ArrayList<Category>();
+			this.snapshot = new AppIndexSnapshot(new Gee.HashMap<string, Application>(), new Gee.HashMap<string, string>());
 
-			// Create our misc category, but don't add it to the list until it actually has apps in it
-			this.misc_category = new Category(_("Other"), true) {
-				excluded_categories = { "Core", "Screensaver", "Settings" },
-				// All of these should be in Utilities
-				excluded_applications = { "htop.desktop", "onboard.desktop", "org.gnome.FileRoller.desktop", "org.gnome.font-viewer.desktop" }
-			};
+			// Switcheroo connects to DBus when its class is initialized, which
+			// has to happen on the main thread rather than in a refresh
+			typeof(Switcheroo).class_ref();
 
 			this.monitor = AppInfoMonitor.@get();
 			this.monitor.changed.connect(() => {
-				this.queue_refresh();
+				// Only the changed desktop files need to be reprocessed
+				this.schedule_refresh(3);
 			});
 
 			// Start watching the desktop-directories folder for custom category support
@@ -58,15 +82,24 @@ namespace Budgie {
 			try {
 				this.file_monitor = directory_file.monitor_directory(FileMonitorFlags.NONE, null);
 				this.file_monitor.changed.connect(() => {
-					// Refresh the index when there is a category file change
+					// Rebuild the index when there is a category file change
 					this.queue_refresh();
 				});
 			} catch (IOError e) {
 				debug("Failed to create monitor for desktop directory: %s", e.message);
 			}
 
-			// Start building the tree right now
-			this.refresh();
+			// Fill the index from the on-disk cache if we can, otherwise
+			// start building the tree right now
+			this.cache = new AppIndexCache();
+			if (this.restore_from_cache()) {
+				// Verify the cache in the background. Stale caches need to
+				// be refreshed soon, but fresh ones still get checked so that
+				// edits inside of the application directories are picked up.
+				this.schedule_refresh(this.cache.stale ? 1 : 30);
+			} else {
+				this.refresh.begin();
+			}
 		}
 
 		/**
@@ -85,23 +118,32 @@ namespace Budgie {
 
 		/**
 		 * Get all of the registered categories with applications in them.
+		 *
+		 * The returned list belongs to the current snapshot of the index,
+		 * and must not be modified.
 		 */
 		public Gee.ArrayList<Category> get_categories() {
-			if (categories == null) {
-				warning("Trying to access application categories, but it is null!");
-				categories = new Gee.ArrayList<Category>();
-			}
-
-			return categories;
+			return this.snapshot.categories;
 		}
 
 		/**
 		* Queue an update of the application system to run.
 		*
+		* This rebuilds all of the categories and always results in the
+		* `changed()` signal being emitted.
+		*
 		* The time to wait before refreshing can be set by passing
 		* in the number of seconds. By default the time is 3 seconds.
 		*/
 		public void queue_refresh(int seconds = 3) {
+			this.rebuild_pending = true;
+			this.schedule_refresh(seconds);
+		}
+
+		/**
+		 * Schedule a refresh of the index after the given number of seconds.
+		 */
+		private void schedule_refresh(int seconds) {
 			// Reset the refresh timer if an update is already queued
 			if (this.timeout_id != 0) {
 				Source.remove(this.timeout_id);
@@ -110,26 +152,284 @@ namespace Budgie {
 
 			// Update the application system after the timeout
 			this.timeout_id = Timeout.add_seconds(seconds, () => {
-				this.refresh();
+				this.refresh.begin();
 				this.timeout_id = 0;
 				return Source.REMOVE;
 			});
 		}
 
 		/**
-		* Rebuild the entire app and category indexes.
+		* Update the app and category indexes.
+		*
+		* The desktop files are scanned on a worker thread, which builds a
+		* new snapshot of the index if anything changed. The new snapshot is
+		* published from the main thread, followed by the change signals.
 		*
-		* This iterates over all AppInfos on the system, so it is likely to be
-		* costly to call this function.
+		* Only one refresh runs at a time. Refreshes requested while one is
+		* running are coalesced and run once it has finished.
 		*/
-		private void refresh() {
-			if (categories == null) {
-				warning("Trying to refresh the application index, but it is null!");
-				categories = new Gee.ArrayList<Category>();
+		private async void refresh() {
+			if (this.refreshing) {
+				this.refresh_queued = true;
+				return;
 			}
 
-			categories.clear();
-			this.misc_category.apps.clear();
+			this.refreshing = true;
+
+			do {
+				this.refresh_queued = false;
+
+				bool rebuild = this.rebuild_pending;
+				this.rebuild_pending = false;
+
+				AppIndexSnapshot current = this.snapshot;
+				AppIndexRefresh? result = null;
+				yield run_in_thread(() => {
+					result = scan(current, rebuild);
+				});
+
+				if (result.snapshot == null) {
+					debug("Application index refreshed with no changes");
+
+					// Skipped desktop files can change without changing the index,
+					// so keep their stamps to avoid parsing them again
+					bool stamps_changed = !stamps_equal(result.stamps, current.stamps);
+					if (stamps_changed) {
+						current = current.with_stamps(result.stamps);
+						this.snapshot = current;
+					}
+
+					// Make sure the next login doesn't think the cache is stale
+					if (stamps_changed || this.cache.stale || !this.cache.has_directory_stamps(result.directory_stamps)) {
+						yield this.save_cache(current, result.directory_stamps);
+					}
+					continue;
+				}
+
+				// Icons can only be checked against the theme from the main thread
+				foreach (var application in result.added) {
+					application.check_icon();
+				}
+				foreach (var application in result.updated) {
+					application.check_icon();
+				}
+
+				// Publish the new snapshot
+				this.snapshot = result.snapshot;
+
+				// Emit our signals for changes
+				if (result.has_app_changes()) {
+					this.apps_changed(result.added, result.removed, result.updated);
+				}
+				this.changed();
+
+				yield this.save_cache(result.snapshot, result.directory_stamps);
+			} while (this.refresh_queued);
+
+			this.refreshing = false;
+		}
+
+		/**
+		 * Check if two sets of desktop file stamps are the same.
+		 */
+		private static bool stamps_equal(Gee.Map<string, string> a, Gee.Map<string, string> b) {
+			if (a.size != b.size) {
+				return false;
+			}
+
+			foreach (var entry in a.entries) {
+				if (b.get(entry.key) != entry.value) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * Run a function on a worker thread, finishing once it returns.
+		 *
+		 * The function is run on the calling thread if a worker thread
+		 * can't be started.
+		 */
+		private static async void run_in_thread(owned ThreadFunc<void> func) {
+			SourceFunc callback = run_in_thread.callback;
+
+			try {
+				new Thread<void>.try("budgie-appindex", () => {
+					func();
+					Idle.add((owned) callback);
+				});
+			} catch (Error e) {
+				warning("Unable to start application index thread: %s", e.message);
+				func();
+				Idle.add((owned) callback);
+			}
+
+			yield;
+		}
+
+		/**
+		 * Scan the installed desktop files for changes against the given
+		 * snapshot.
+		 *
+		 * This runs on a worker thread, so it must not touch the state of
+		 * the index. The current snapshot is only read from.
+		 */
+		private static AppIndexRefresh scan(AppIndexSnapshot current, bool rebuild) {
+			var result = new AppIndexRefresh();
+
+			// Taken before scanning so that changes made during the refresh mark the cache as stale
+			result.directory_stamps = AppIndexCache.get_directory_stamps();
+
+			var applications = new Gee.HashMap<string, Application>();
+			var stamps = new Gee.HashMap<string, string>();
+			var seen = new Gee.HashSet<string>();
+
+			// Iterate over all registered AppInfos and look for changes
+			foreach (var app in AppInfo.get_all()) {
+				unowned var desktop_app = app as DesktopAppInfo;
+				if (desktop_app == null) {
+					continue;
+				}
+
+				unowned var desktop_id = desktop_app.get_id();
+				if (desktop_id == null || !seen.add(desktop_id)) {
+					continue;
+				}
+
+				var stamp = get_stamp(desktop_app);
+				var existing = current.applications.get(desktop_id);
+
+				if (stamp != null) {
+					stamps.set(desktop_id, stamp);
+				}
+
+				// Nothing changed for this desktop file
+				if (stamp != null && current.stamps.get(desktop_id) == stamp) {
+					if (existing != null) {
+						applications.set(desktop_id, existing);
+					}
+					continue;
+				}
+
+				var application = create_application(desktop_app);
+
+				// The application should no longer be shown
+				if (application == null) {
+					if (existing != null) {
+						result.removed.add(existing);
+					}
+					continue;
+				}
+
+				applications.set(desktop_id, application);
+
+				if (existing != null) {
+					result.updated.add(application);
+				} else {
+					result.added.add(application);
+				}
+			}
+
+			// Drop all of the applications that have been uninstalled
+			foreach (var entry in current.applications.entries) {
+				if (!seen.contains(entry.key)) {
+					result.removed.add(entry.value);
+				}
+			}
+
+			result.stamps = stamps;
+
+			if (!rebuild && !result.has_app_changes()) {
+				return result;
+			}
+
+			// Sort everything into a fresh set of categories
+			var snapshot = new AppIndexSnapshot(applications, stamps);
+			build_categories(snapshot);
+			foreach (var application in applications.values) {
+				snapshot.sort_application(application);
+			}
+			snapshot.finish();
+
+			result.snapshot = snapshot;
+			return result;
+		}
+
+		/**
+		 * Fill the index from the on-disk cache.
+		 *
+		 * Returns `false` if there is no usable cache, in which case the index
+		 * has to be built from the desktop files.
+		 */
+		private bool restore_from_cache() {
+			if (!this.cache.load()) {
+				return false;
+			}
+
+			// The icon theme may have changed since the cache was written
+			foreach (var application in this.cache.applications.values) {
+				application.check_icon();
+			}
+
+			var applications = new Gee.HashMap<string, Application>();
+			applications.set_all(this.cache.applications);
+			var stamps = new Gee.HashMap<string, string>();
+			stamps.set_all(this.cache.stamps);
+
+			var snapshot = new AppIndexSnapshot(applications, stamps);
+			build_categories(snapshot);
+			this.rebuild_pending = false;
+
+			// Put the applications back in the categories they were in
+			foreach (var category in snapshot.get_all_categories()) {
+				var members = this.cache.get_members(category.name);
+				if (members == null) {
+					// This category is new, so everything has to be sorted again
+					this.rebuild_pending = true;
+					continue;
+				}
+
+				foreach (var desktop_id in members) {
+					var application = snapshot.applications.get(desktop_id);
+					if (application != null) {
+						category.apps.add(application);
+					}
+				}
+			}
+
+			// The custom categories may have changed since the cache was written
+			if (this.cache.stale) {
+				this.rebuild_pending = true;
+			}
+
+			snapshot.finish();
+			this.snapshot = snapshot;
+
+			// The restored records are owned by the index now
+			this.cache.applications.clear();
+			this.cache.stamps.clear();
+
+			return true;
+		}
+
+		/**
+		 * Write a snapshot of the index to the on-disk cache from a worker
+		 * thread.
+		 */
+		private async void save_cache(AppIndexSnapshot snapshot, Gee.Map<string, uint64?> directory_stamps) {
+			yield run_in_thread(() => {
+				this.cache.save(directory_stamps, snapshot.stamps, snapshot.applications.values, snapshot.get_all_categories());
+			});
+		}
+
+		/**
+		 * Create all of the categories in a new snapshot, without any
+		 * applications in them.
+		 */
+		private static void build_categories(AppIndexSnapshot snapshot) {
+			var categories = snapshot.categories;
 
 			/*
 			* Add our categories, adhearing to the Freedesktop Menu spec.
@@ -204,36 +504,14 @@ namespace Budgie {
 			});
 
 			// See if there are any user-custom categories
-			this.create_custom_categories();
-
-			// Iterate over all registered AppInfos and try to put them in categories
-			foreach (var app in AppInfo.get_all()) {
-				unowned var desktop_app = app as DesktopAppInfo;
-				if (desktop_app == null) {
-					continue;
-				}
-
-				// Sort the application based on its DesktopAppInfo
-				this.sort_application(desktop_app);
-			}
-
-			// Add the misc category if there are apps in it
-			if (this.misc_category.apps.size > 0) {
-				this.categories.add(this.misc_category);
-			}
-
-			// sort the categories
-			this.categories.sort((a, b) => a.name.collate(b.name));
-
-			// Emit our signal for changes
-			this.changed();
+			create_custom_categories(snapshot);
 		}
 
 		/**
 		 * Read files in `~/.local/share/desktop-directories` and add a new category
 		 * for each of them.
 		 */
-		private void create_custom_categories() {
+		private static void create_custom_categories(AppIndexSnapshot snapshot) {
 			var path = Path.build_path(Path.DIR_SEPARATOR_S, Environment.get_home_dir(), ".local", "share", "desktop-directories");
 			var directory_file = File.new_for_path(path);
 
@@ -262,7 +540,7 @@ namespace Budgie {
 						var category = Category.new_for_file(file);
 
 						debug("Adding custom category '%s'", category.name);
-						this.categories.add(category);
+						snapshot.categories.add(category);
 					} catch (Error e) {
 						// There was an error reading the file, skip
 						warning("Error creating category from '%s': %s", child.get_name(), e.message);
@@ -275,9 +553,45 @@ namespace Budgie {
 		}
 
 		/**
-		 * Sort a single application into the proper categories.
+		 * Get a stamp identifying the current version of an application's
+		 * desktop file.
+		 *
+		 * Returns `null` if the desktop file could not be queried, in which
+		 * case the application should always be reprocessed.
+		 */
+		private static string? get_stamp(DesktopAppInfo app_info) {
+			unowned var filename = app_info.get_filename();
+			if (filename == null) {
+				return null;
+			}
+
+			try {
+				var file = File.new_for_path(filename);
+				var info = file.query_info(
+					FileAttribute.TIME_MODIFIED + "," + FileAttribute.TIME_MODIFIED_USEC + "," + FileAttribute.STANDARD_SIZE,
+					FileQueryInfoFlags.NONE,
+					null
+				);
+
+				return "%s:%s.%s:%s".printf(
+					filename,
+					info.get_attribute_uint64(FileAttribute.TIME_MODIFIED).to_string(),
+					info.get_attribute_uint32(FileAttribute.TIME_MODIFIED_USEC).to_string(),
+					info.get_size().to_string()
+				);
+			} catch (Error e) {
+				debug("Unable to query desktop file '%s': %s", filename, e.message);
+				return null;
+			}
+		}
+
+		/**
+		 * Create an application for the index from its DesktopAppInfo.
+		 *
+		 * Returns `null` if the application should not be in the index. The
+		 * icon of the application still has to be checked from the main thread.
 		 */
-		private void sort_application(DesktopAppInfo app_info) {
+		private static Application? create_application(DesktopAppInfo app_info) {
 			// Check if this is a control center panel
 			var control_center = "budgie-control-center";
 			bool is_control_center_panel = (
@@ -293,11 +607,76 @@ namespace Budgie {
 			bool should_skip = !app_info.should_show() && !is_control_center_panel;
 
 			if (should_skip) {
-				return;
+				return null;
 			}
 
-			var application = new Application(app_info);
+			return new Application.without_icon_check(app_info);
+		}
+	}
+
+	/**
+	 * Immutable state of the application index.
+	 *
+	 * Snapshots are filled in by a refresh, possibly on a worker thread,
+	 * and are never modified after they have been published by the index.
+	 */
+	private class AppIndexSnapshot {
+		/** List of all categories with apps in them. */
+		public Gee.ArrayList<Category> categories;
+		public Category misc_category;
+
+		/** Map of desktop IDs to indexed applications. */
+		public Gee.HashMap<string, Application> applications;
+
+		/**
+		 * Map of desktop IDs to the stamp of the desktop file they were
+		 * last indexed from. This includes entries that we skipped, so
+		 * that hidden applications aren't reprocessed on every refresh.
+		 */
+		public Gee.HashMap<string, string> stamps;
+
+		public AppIndexSnapshot(Gee.HashMap<string, Application> applications, Gee.HashMap<string, string> stamps) {
+			this.categories = new Gee.ArrayList<Category>();
+			this.applications = applications;
+			this.stamps = stamps;
 
+			// Create our misc category, but don't add it to the list until it actually has apps in it
+			this.misc_category = new Category(_("Other"), true) {
+				excluded_categories = { "Core", "Screensaver", "Settings" },
+				// All of these should be in Utilities
+				excluded_applications = { "htop.desktop", "onboard.desktop", "org.gnome.FileRoller.desktop", "org.gnome.font-viewer.desktop" }
+			};
+		}
+
+		/**
+		 * Create a copy of this snapshot with different desktop file stamps,
+		 * sharing everything else.
+		 */
+		public AppIndexSnapshot with_stamps(Gee.HashMap<string, string> stamps) {
+			var snapshot = new AppIndexSnapshot(this.applications, stamps);
+			snapshot.categories = this.categories;
+			snapshot.misc_category = this.misc_category;
+			return snapshot;
+		}
+
+		/**
+		 * Get all of the categories, including the misc category even if it
+		 * is empty.
+		 */
+		public Gee.List<Category> get_all_categories() {
+			var all_categories = new Gee.ArrayList<Category>();
+			all_categories.add_all(this.categories);
+			if (!all_categories.contains(this.misc_category)) {
+				all_categories.add(this.misc_category);
+			}
+
+			return all_categories;
+		}
+
+		/**
+		 * Sort a single application into the proper categories.
+		 */
+		public void sort_application(Application application) {
 			// Try to get the best category for this app
 			bool category_found = false;
 			// Iterate over all of this application's categories
@@ -312,5 +691,41 @@ namespace Budgie {
 				this.misc_category.maybe_add_app(application);
 			}
 		}
+
+		/**
+		 * Finish filling in the snapshot once all applications are sorted.
+		 */
+		public void finish() {
+			// Add the misc category only if there are apps in it
+			if (this.misc_category.apps.size > 0) {
+				this.categories.add(this.misc_category);
+			}
+
+			// sort the categories
+			this.categories.sort((a, b) => a.name.collate(b.name));
+		}
+	}
+
+	/**
+	 * The outcome of scanning the desktop files for changes.
+	 */
+	private class AppIndexRefresh {
+		/** The new state of the index, or `null` if nothing changed. */
+		public AppIndexSnapshot? snapshot = null;
+
+		public Gee.ArrayList<Application> added = new Gee.ArrayList<Application>();
+		public Gee.ArrayList<Application> removed = new Gee.ArrayList<Application>();
+		public Gee.ArrayList<Application> updated = new Gee.ArrayList<Application>();
+
+		/** Modification times of the application directories before the scan. */
+		public Gee.HashMap<string, uint64?> directory_stamps;
+
+		/** Stamps of all of the desktop files that were scanned. */
+		public Gee.HashMap<string, string> stamps;
+
+		/** Whether any applications were added, removed, or updated. */
+		public bool has_app_changes() {
+			return !this.added.is_empty || !this.removed.is_empty || !this.updated.is_empty;
+		}
 	}
 }
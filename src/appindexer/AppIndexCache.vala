@@ -0,0 +1,261 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie {
+	/**
+	* Persistent on-disk cache of the application index.
+	*
+	* The cache is a single serialized GVariant that is mapped into memory
+	* when loading, so a warm login can fill the index without parsing any
+	* desktop files. It holds the flattened application records, the stamps
+	* of their desktop files, and the category membership of every app.
+	*/
+	public class AppIndexCache : Object {
+		/**
+		* Version of the cache format. Bump this whenever the layout of
+		* the cache or of `Application.VARIANT_TYPE` changes.
+		*/
+		private const uint32 VERSION = 2;
+
+		/*
+		* Layout: version, locale, directory mtimes, desktop file stamps,
+		* application records (see `Application.VARIANT_TYPE`), and category
+		* names to desktop IDs.
+		*/
+		private const string VARIANT_TYPE = "(usa{st}a{ss}a(sssssssasasasvbbb)a{sas})";
+
+		/** The path of the cache file. */
+		public string path { get; construct; }
+
+		/**
+		* Whether the loaded cache is older than the application directories.
+		*/
+		public bool stale { get; private set; default = true; }
+
+		/** Map of desktop IDs to the applications restored from the cache. */
+		public Gee.HashMap<string, Application> applications { get; private set; }
+
+		/** Map of desktop IDs to the desktop file stamps restored from the cache. */
+		public Gee.HashMap<string, string> stamps { get; private set; }
+
+		/* Map of category names to the desktop IDs in them */
+		private Gee.HashMap<string, Gee.ArrayList<string>> memberships;
+
+		/* Directory mtimes of the cache file as it is on disk */
+		private Gee.HashMap<string, uint64?> directory_stamps;
+
+		public AppIndexCache() {
+			Object(path: Path.build_filename(Environment.get_user_cache_dir(), "budgie-desktop", "appindex.cache"));
+		}
+
+		construct {
+			this.applications = new Gee.HashMap<string, Application>();
+			this.stamps = new Gee.HashMap<string, string>();
+			this.memberships = new Gee.HashMap<string, Gee.ArrayList<string>>();
+			this.directory_stamps = new Gee.HashMap<string, uint64?>();
+		}
+
+		/**
+		* Get the modification times of all of the directories that
+		* desktop files and custom categories are read from.
+		*/
+		public static Gee.HashMap<string, uint64?> get_directory_stamps() {
+			var stamps = new Gee.HashMap<string, uint64?>();
+
+			string[] dirs = { Path.build_filename(Environment.get_user_data_dir(), "applications") };
+			foreach (unowned var data_dir in Environment.get_system_data_dirs()) {
+				dirs += Path.build_filename(data_dir, "applications");
+			}
+			dirs += Path.build_filename(Environment.get_home_dir(), ".local", "share", "desktop-directories");
+
+			foreach (var dir in dirs) {
+				uint64 mtime = 0;
+
+				try {
+					var info = File.new_for_path(dir).query_info(
+						FileAttribute.TIME_MODIFIED + "," + FileAttribute.TIME_MODIFIED_USEC,
+						FileQueryInfoFlags.NONE,
+						null
+					);
+					mtime = info.get_attribute_uint64(FileAttribute.TIME_MODIFIED) * 1000000 + info.get_attribute_uint32(FileAttribute.TIME_MODIFIED_USEC);
+				} catch (Error e) {
+					// Directory doesn't exist, which is tracked as a zero mtime
+				}
+
+				stamps.set(dir, mtime);
+			}
+
+			return stamps;
+		}
+
+		/**
+		* Get the key identifying the locale that application names were
+		* translated into.
+		*/
+		private static string get_locale_key() {
+			return string.joinv(":", Intl.get_language_names());
+		}
+
+		/**
+		* Check if the cache on disk was written with the given directory
+		* modification times.
+		*/
+		public bool has_directory_stamps(Gee.Map<string, uint64?> stamps) {
+			if (stamps.size != this.directory_stamps.size) {
+				return false;
+			}
+
+			foreach (var entry in stamps.entries) {
+				if (!this.directory_stamps.has_key(entry.key)) {
+					return false;
+				}
+
+				uint64 saved = this.directory_stamps.get(entry.key);
+				uint64 mtime = entry.value;
+				if (saved != mtime) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		* Get the desktop IDs of the applications that were in a category
+		* when the cache was written.
+		*
+		* Returns `null` if the category was not in the cache.
+		*/
+		public Gee.List<string>? get_members(string category_name) {
+			return this.memberships.get(category_name);
+		}
+
+		/**
+		* Load the cache file from disk.
+		*
+		* Returns `true` if a cache compatible with this version and locale
+		* was loaded. Check `stale` to see if the application directories
+		* have changed since it was written.
+		*/
+		public bool load() {
+			this.applications.clear();
+			this.stamps.clear();
+			this.memberships.clear();
+			this.directory_stamps.clear();
+			this.stale = true;
+
+			Variant data;
+			try {
+				var mapped = new MappedFile(this.path, false);
+				data = new Variant.from_bytes(new VariantType(VARIANT_TYPE), mapped.get_bytes(), false);
+			} catch (FileError e) {
+				if (!(e is FileError.NOENT)) {
+					warning("Unable to read application index cache: %s", e.message);
+				}
+				return false;
+			}
+
+			if (data.get_child_value(0).get_uint32() != VERSION) {
+				debug("Ignoring application index cache from a different version");
+				return false;
+			}
+
+			if (data.get_child_value(1).get_string() != get_locale_key()) {
+				debug("Ignoring application index cache from a different locale");
+				return false;
+			}
+
+			var cached_dirs = data.get_child_value(2);
+			for (size_t i = 0; i < cached_dirs.n_children(); i++) {
+				var entry = cached_dirs.get_child_value(i);
+				this.directory_stamps.set(entry.get_child_value(0).get_string(), entry.get_child_value(1).get_uint64());
+			}
+
+			var cached_stamps = data.get_child_value(3);
+			for (size_t i = 0; i < cached_stamps.n_children(); i++) {
+				var entry = cached_stamps.get_child_value(i);
+				this.stamps.set(entry.get_child_value(0).get_string(), entry.get_child_value(1).get_string());
+			}
+
+			var cached_apps = data.get_child_value(4);
+			for (size_t i = 0; i < cached_apps.n_children(); i++) {
+				var application = new Application.from_variant(cached_apps.get_child_value(i));
+				this.applications.set(application.desktop_id, application);
+			}
+
+			var cached_memberships = data.get_child_value(5);
+			for (size_t i = 0; i < cached_memberships.n_children(); i++) {
+				var entry = cached_memberships.get_child_value(i);
+				var ids = new Gee.ArrayList<string>();
+				ids.add_all_array(entry.get_child_value(1).dup_strv());
+				this.memberships.set(entry.get_child_value(0).get_string(), ids);
+			}
+
+			// Check if any of the application directories changed
+			this.stale = !this.has_directory_stamps(get_directory_stamps());
+			debug("Loaded %d applications from the application index cache", this.applications.size);
+			return true;
+		}
+
+		/**
+		* Write the given index state to the cache file.
+		*
+		* The directory stamps should be taken before the index was
+		* refreshed, so that changes made during the refresh mark the
+		* cache as stale.
+		*/
+		public void save(Gee.Map<string, uint64?> directory_stamps, Gee.Map<string, string> stamps, Gee.Collection<Application> applications, Gee.Collection<Category> categories) {
+			var dirs_builder = new VariantBuilder(new VariantType("a{st}"));
+			foreach (var entry in directory_stamps.entries) {
+				dirs_builder.add_value(new Variant.dict_entry(new Variant.string(entry.key), new Variant.uint64(entry.value)));
+			}
+
+			var stamps_builder = new VariantBuilder(new VariantType("a{ss}"));
+			foreach (var entry in stamps.entries) {
+				stamps_builder.add_value(new Variant.dict_entry(new Variant.string(entry.key), new Variant.string(entry.value)));
+			}
+
+			var apps_builder = new VariantBuilder(new VariantType("a" + Application.VARIANT_TYPE));
+			foreach (var application in applications) {
+				apps_builder.add_value(application.to_variant());
+			}
+
+			var categories_builder = new VariantBuilder(new VariantType("a{sas}"));
+			foreach (var category in categories) {
+				string[] ids = {};
+				foreach (var application in category.apps) {
+					ids += application.desktop_id;
+				}
+				categories_builder.add_value(new Variant.dict_entry(new Variant.string(category.name), new Variant.strv(ids)));
+			}
+
+			var data = new Variant.tuple({
+				new Variant.uint32(VERSION),
+				new Variant.string(get_locale_key()),
+				dirs_builder.end(),
+				stamps_builder.end(),
+				apps_builder.end(),
+				categories_builder.end(),
+			});
+
+			try {
+				DirUtils.create_with_parents(Path.get_dirname(this.path), 0755);
+				// set_data writes to a temporary file first, so readers never see a partial cache
+				FileUtils.set_data(this.path, data.get_data_as_bytes().get_data());
+				this.directory_stamps.clear();
+				this.directory_stamps.set_all(directory_stamps);
+				this.stale = false;
+			} catch (FileError e) {
+				warning("Unable to write application index cache: %s", e.message);
+			}
+		}
+	}
+}
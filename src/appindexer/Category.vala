@@ -23,10 +23,33 @@ namespace Budgie {
 		*/
 		public bool misc_category { get; construct; }
 
-		public string[] included_categories;
-		public string[] excluded_categories;
+		/** Categories that applications can have to be in this category. */
+		public string[] included_categories {
+			get { return _included_categories; }
+			set {
+				_included_categories = value;
+				included_quarks = intern(value);
+			}
+		}
+
+		/** Categories that keep applications out of this category. */
+		public string[] excluded_categories {
+			get { return _excluded_categories; }
+			set {
+				_excluded_categories = value;
+				excluded_quarks = intern(value);
+			}
+		}
+
 		public string[] excluded_applications;
 
+		private string[] _included_categories = {};
+		private string[] _excluded_categories = {};
+
+		/* The category rules, compiled to quarks */
+		private Quark[] included_quarks = {};
+		private Quark[] excluded_quarks = {};
+
 		/** The list of applications in this category. */
 		public Gee.ArrayList<Application> apps { get; private set; default = new Gee.ArrayList<Application>(); }
 
@@ -70,6 +93,14 @@ namespace Budgie {
 			};
 		}
 
+		private static Quark[] intern(string[] categories) {
+			Quark[] quarks = {};
+			foreach (unowned var category in categories) {
+				quarks += Quark.from_string(category);
+			}
+			return quarks;
+		}
+
 		/**
 		* Add an application to this category if the app belongs in
 		* this category.
@@ -95,15 +126,15 @@ namespace Budgie {
 				return true;
 			}
 
-			// Split the categories and see if this category is in the list
+			// See if this category is in the application's pre-parsed categories
 			bool found_category = false;
-			foreach (unowned var category in categories.split(";")) {
+			foreach (var category in app.get_category_quarks()) {
 				// Don't include the application if the sub-category is excluded from this category
-				if (category in excluded_categories) {
+				if (category in excluded_quarks) {
 					return false;
 				}
 
-				if (category in included_categories) {
+				if (category in included_quarks) {
 					// Mark that we found a fitting category
 					found_category = true;
 				}
@@ -24,8 +24,53 @@ namespace Budgie {
 		/** Static map of desktop IDs to scores. */
 		private static Gee.HashMap<string, int> scores;
 
+		/** Static map of desktop IDs to normalized search records. */
+		private static Gee.HashMap<string, SearchRecord> records;
+
+		/**
+		 * Static map of content types to the desktop ID of their default
+		 * handler, or an empty string if there is none.
+		 */
+		private static Gee.HashMap<string, string> default_handlers;
+
+		/**
+		 * Contiguous buffer of the nul-terminated fuzzy fields of every
+		 * indexed application, so they can be scored in one batch.
+		 */
+		private static ByteArray? corpus = null;
+		private static SearchRecord[] corpus_records = {};
+		private static string? corpus_term = null;
+
+		private static AppInfoMonitor? app_monitor = null;
+		private static bool index_connected = false;
+
+		/* Reusable Bitap state, so that scoring doesn't allocate */
+		private Fuzzer.State fuzzer_state = new Fuzzer.State();
+
+		/* Tokens and ASCII alternates of the last search term */
+		private string? tokenized_term = null;
+		private string[] term_tokens = {};
+
 		static construct {
 			scores = new Gee.HashMap<string, int>();
+			records = new Gee.HashMap<string, SearchRecord>();
+			default_handlers = new Gee.HashMap<string, string>();
+		}
+
+		construct {
+			// Drop the search records of applications when they change
+			if (!index_connected) {
+				AppIndex.@get().apps_changed.connect(on_index_apps_changed);
+				AppIndex.@get().changed.connect(on_index_changed);
+				index_connected = true;
+			}
+
+			// Default handlers can change without any desktop file changing,
+			// e.g. when mimeapps.list is edited
+			if (app_monitor == null) {
+				app_monitor = AppInfoMonitor.@get();
+				app_monitor.changed.connect(on_app_info_changed);
+			}
 		}
 
 		/**
@@ -79,6 +124,167 @@ namespace Budgie {
 			scores.clear();
 		}
 
+		private static void on_index_apps_changed(Gee.List<Application> added, Gee.List<Application> removed, Gee.List<Application> updated) {
+			foreach (var app in removed) {
+				records.unset(app.desktop_id);
+			}
+
+			foreach (var app in updated) {
+				records.unset(app.desktop_id);
+			}
+
+			default_handlers.clear();
+		}
+
+		private static void on_index_changed() {
+			// Rebuild the corpus on the next search
+			corpus = null;
+			corpus_records = {};
+			corpus_term = null;
+		}
+
+		private static void on_app_info_changed() {
+			default_handlers.clear();
+		}
+
+		/**
+		 * Build the corpus of fuzzy fields from the applications in the index.
+		 */
+		private void ensure_corpus() {
+			if (corpus != null) {
+				return;
+			}
+
+			corpus = new ByteArray();
+			corpus_records = {};
+			uint8[] terminator = { 0 };
+
+			var seen = new Gee.HashSet<string>();
+			foreach (var category in AppIndex.@get().get_categories()) {
+				foreach (var app in category.apps) {
+					if (!seen.add(app.desktop_id)) {
+						continue;
+					}
+
+					var record = get_record(app);
+					record.field_offsets = {};
+
+					foreach (unowned var field in record.fuzzy_fields) {
+						record.field_offsets += corpus.len;
+						corpus.append(field.data);
+						corpus.append(terminator);
+					}
+
+					corpus_records += record;
+				}
+			}
+		}
+
+		/**
+		 * Fuzzy match a term against every application in the corpus with
+		 * one batched call.
+		 *
+		 * Applications that can't match because they didn't match a prefix
+		 * of the term are left out of the batch.
+		 */
+		private void score_corpus(string term) {
+			ensure_corpus();
+			corpus_term = term;
+
+			uint[] offsets = {};
+			int[] owners = {};
+
+			for (int i = 0; i < corpus_records.length; i++) {
+				unowned var record = corpus_records[i];
+				record.fuzzy_term = term;
+				record.fuzzy_score = -1;
+
+				if (record.miss_term != null && term.has_prefix(record.miss_term)) {
+					continue;
+				}
+
+				foreach (var offset in record.field_offsets) {
+					offsets += offset;
+					owners += i;
+				}
+			}
+
+			var results = new int[offsets.length];
+			int64 start = get_monotonic_time();
+			var pattern = new Fuzzer.Pattern(term, 1);
+			pattern.score_many(corpus.data, offsets, results);
+			int64 elapsed = get_monotonic_time() - start;
+
+			debug(
+				"Fuzzy scored %d fields of %d applications for '%s' in %dus (%.1f ns/score)",
+				offsets.length,
+				corpus_records.length,
+				term,
+				(int) elapsed,
+				offsets.length > 0 ? (elapsed * 1000.0) / offsets.length : 0.0
+			);
+
+			// Keep the best score of every application
+			for (int i = 0; i < offsets.length; i++) {
+				unowned var record = corpus_records[owners[i]];
+				int score = results[i];
+
+				if (score >= 0 && (score < record.fuzzy_score || record.fuzzy_score == -1)) {
+					record.fuzzy_score = score;
+				}
+			}
+
+			foreach (unowned var record in corpus_records) {
+				if (record.fuzzy_score < 0 && (record.miss_term == null || !term.has_prefix(record.miss_term))) {
+					record.miss_term = term;
+				}
+			}
+		}
+
+		/**
+		 * Get the best fuzzy score of an application's name, generic name and
+		 * keywords for a term.
+		 */
+		private int get_fuzzy_score(SearchRecord record, string term) {
+			// Score the whole index the first time a term is seen
+			if (corpus_term != term) {
+				score_corpus(term);
+			}
+
+			if (record.fuzzy_term == term) {
+				return record.fuzzy_score;
+			}
+
+			// This application isn't in the index, so score it on its own.
+			// A term that extends one that didn't match can't match either.
+			record.fuzzy_term = term;
+			if (record.miss_term != null && term.has_prefix(record.miss_term)) {
+				record.fuzzy_score = -1;
+			} else {
+				record.fuzzy_score = get_best_score(record.fuzzy_fields, term);
+				if (record.fuzzy_score < 0) {
+					record.miss_term = term;
+				}
+			}
+
+			return record.fuzzy_score;
+		}
+
+		/**
+		 * Get the normalized search record for an application, creating it
+		 * if it doesn't exist yet or if the application has been updated.
+		 */
+		private SearchRecord get_record(Application app) {
+			var record = records.get(app.desktop_id);
+
+			if (record == null || record.app != app) {
+				record = new SearchRecord(app);
+				records.set(app.desktop_id, record);
+			}
+
+			return record;
+		}
+
 		/**
 		* Determine a score in relation to a given search term.
 		*
@@ -105,17 +311,10 @@ namespace Budgie {
 			}
 
 			string _term = term.casefold();
-
-			string?[] data = {
-				app.name,
-				app.generic_name,
-			};
-			foreach (var k in app.keywords) {
-				data += k;
-			}
+			var record = get_record(app);
 
 			// Get an initial best score from the fuzzy match of name, generic_name and keywords
-			int score = get_best_score(data, _term);
+			int score = get_fuzzy_score(record, _term);
 
 			// Score is less than 0, disqualified
 			if (score < 0) {
@@ -123,7 +322,7 @@ namespace Budgie {
 				return;
 			}
 
-			string name = app.name.casefold();
+			unowned var name = record.name;
 
 			// If the term is considered to be an exact match, bail early
 			if (score == 0) {
@@ -141,13 +340,8 @@ namespace Budgie {
 				score--;
 			}
 
-			string?[] fields = {
-				app.description,
-				app.exec
-			};
-
 			// Check the various fields, prioritize if there's a match
-			if (array_contains(fields, _term)) {
+			if (tokens_match(record.description_tokens, _term) || tokens_match(record.exec_tokens, _term)) {
 				score--;
 			}
 
@@ -163,18 +357,14 @@ namespace Budgie {
 		}
 
 		/**
-    	 * Retrieve the highest score by performing a fuzzy match on a list of strings
+		 * Retrieve the highest score by performing a fuzzy match on a list of
+		 * normalized strings
 		 */
-		private int get_best_score(string?[] elements, string term) {
+		private int get_best_score(string[] elements, string term) {
 			int score = -1;
 
-			foreach (var e in elements) {
-				if (e == null) {
-					continue;
-				}
-
-				string target = searchable_string(e);
-				int tmp_score = Fuzzer.get_fuzzy_score(target, term, 1);
+			foreach (unowned var target in elements) {
+				int tmp_score = fuzzer_state.get_score(target, term, 1);
 
 				if (tmp_score >= 0 && (tmp_score < score || score == -1)) {
 					score = tmp_score;
@@ -184,32 +374,127 @@ namespace Budgie {
 			return score;
 		}
 
-		/* Helper ported from Brisk */
-		private bool array_contains(string?[] array, string term) {
-			foreach (string? field in array) {
-				if (field == null) {
-					continue;
+		/**
+		 * Check if all of the tokens of a field are a prefix of one of the
+		 * search term's tokens or their ASCII alternates.
+		 *
+		 * This is equivalent to `field.match_string(term, true)`, but works on
+		 * field tokens that were folded ahead of time, and only folds the
+		 * search term once per search.
+		 */
+		private bool tokens_match(string[]? field_tokens, string term) {
+			if (field_tokens == null) {
+				return false;
+			}
+
+			// Only tokenize the term once per search
+			if (tokenized_term != term) {
+				string[] alternates;
+				term_tokens = term.tokenize_and_fold(null, out alternates);
+				foreach (unowned var alternate in alternates) {
+					term_tokens += alternate;
 				}
-				string ct = searchable_string(field);
-				if (ct.match_string(term, true)) {
-					return true;
+				tokenized_term = term;
+			}
+
+			foreach (unowned var field_token in field_tokens) {
+				bool found = false;
+
+				foreach (unowned var token in term_tokens) {
+					if (token.has_prefix(field_token)) {
+						found = true;
+						break;
+					}
+				}
+
+				if (!found) {
+					return false;
 				}
 			}
-			return false;
+
+			return true;
 		}
 
 		/**
 		 * Check if an application is the default handler for
 		 * any of its supported MIME types.
+		 *
+		 * Default handlers are cached per content type, so the MIME database
+		 * is only consulted once for every content type until it changes.
 		 */
 		private bool is_default_handler(Application app) {
-			foreach (var content_type in app.content_types) {
-				var default_app = AppInfo.get_default_for_type(content_type, false);
-				if (default_app == null) continue;
-				if (default_app.get_id() == app.desktop_id) return true;
+			foreach (unowned var content_type in app.content_types) {
+				var default_id = default_handlers.get(content_type);
+
+				if (default_id == null) {
+					var default_app = AppInfo.get_default_for_type(content_type, false);
+					default_id = (default_app != null) ? (default_app.get_id() ?? "") : "";
+					default_handlers.set(content_type, default_id);
+				}
+
+				if (default_id == app.desktop_id) return true;
 			}
 
 			return false;
 		}
 	}
+
+	/**
+	 * Normalized, precomputed search data for a single application.
+	 */
+	private class SearchRecord {
+		public Application app;
+
+		/** Casefolded name of the application. */
+		public string name;
+
+		/** Normalized name, generic name, and keywords, for fuzzy matching. */
+		public string[] fuzzy_fields = {};
+
+		/** Folded tokens of the description, or `null` if it is unset. */
+		public string[]? description_tokens = null;
+
+		/** Folded tokens of the command line, or `null` if it is unset. */
+		public string[]? exec_tokens = null;
+
+		/**
+		 * The shortest casefolded term known to not fuzzy match this
+		 * application, if any.
+		 */
+		public string? miss_term = null;
+
+		/** The last term that was fuzzy matched, and its best score. */
+		public string? fuzzy_term = null;
+		public int fuzzy_score = -1;
+
+		/** Offsets of the fuzzy fields in the batch corpus. */
+		public uint[] field_offsets = {};
+
+		public SearchRecord(Application app) {
+			this.app = app;
+			this.name = app.name.casefold();
+			this.fuzzy_fields += RelevancyService.searchable_string(app.name);
+
+			if (app.generic_name != null) {
+				this.fuzzy_fields += RelevancyService.searchable_string(app.generic_name);
+			}
+			if (app.keywords != null) {
+				foreach (unowned var keyword in app.keywords) {
+					this.fuzzy_fields += RelevancyService.searchable_string(keyword);
+				}
+			}
+
+			this.description_tokens = tokenize(app.description);
+			this.exec_tokens = tokenize(app.exec);
+		}
+
+		private static string[]? tokenize(string? field) {
+			if (field == null) {
+				return null;
+			}
+
+			string[] alternates;
+			return RelevancyService.searchable_string(field).tokenize_and_fold(null, out alternates);
+		}
+	}
 }
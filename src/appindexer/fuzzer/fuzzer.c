@@ -1,11 +1,304 @@
-#include <limits.h>
-#include <stdlib.h>
 #include <string.h>
 
 #include "fuzzer.h"
 
+/* Number of bits in one word of a bitset */
+#define FUZZER_WORD_BITS 64
+
+/* Index of the mask used for characters that are not in the pattern */
+#define FUZZER_NO_MATCH 0
+
+struct _FuzzerPattern {
+	/* The pattern that the masks were compiled for */
+	gchar* pattern;
+	gint max_distance;
+
+	/* Whether the pattern could be compiled, patterns that are too long never match */
+	gboolean valid;
+
+	/* Pattern length in characters, and the number of words per bitset */
+	gsize pattern_length;
+	gsize n_words;
+
+	/* Mask index of every ASCII character, FUZZER_NO_MATCH if unused */
+	guint16 ascii_index[128];
+
+	/* Distinct non-ASCII characters of the pattern and their mask index */
+	gunichar* wide_chars;
+	guint16* wide_index;
+	gsize n_wide_chars;
+
+	/* One bitset per distinct character, after the all-ones bitset */
+	guint64* masks;
+	gsize n_masks;
+
+	/* One bitset per allowed distance, plus the shift carry per distance */
+	guint64* bit_array;
+	guint64* carries;
+
+	/* Allocated sizes, so that buffers are only grown when needed */
+	gsize pattern_capacity;
+	gsize masks_capacity;
+	gsize bits_capacity;
+	gsize carries_capacity;
+};
+
+struct _FuzzerState {
+	/* The masks of the last pattern, recompiled whenever the pattern changes */
+	FuzzerPattern pattern;
+};
+
+static GPrivate shared_state = G_PRIVATE_INIT((GDestroyNotify) fuzzer_state_free);
+
 /**
- * fuzzer_get_fuzzy_score:
+ * fuzzer_state_new:
+ *
+ * Creates a new, reusable fuzzy matching state.
+ *
+ * The state keeps the compiled masks of the last pattern and its working
+ * buffers around, so scoring many texts with the same state does not
+ * allocate any memory.
+ *
+ * Return value: (transfer full): a new #FuzzerState
+ */
+FuzzerState* fuzzer_state_new(void) {
+	return g_new0(FuzzerState, 1);
+}
+
+/* Frees the buffers of a pattern, but not the pattern itself */
+static void fuzzer_pattern_clear(FuzzerPattern* pattern) {
+	g_free(pattern->pattern);
+	g_free(pattern->wide_chars);
+	g_free(pattern->wide_index);
+	g_free(pattern->masks);
+	g_free(pattern->bit_array);
+	g_free(pattern->carries);
+}
+
+/**
+ * fuzzer_state_free:
+ * @state: a #FuzzerState
+ *
+ * Frees a fuzzy matching state and all of its buffers.
+ */
+void fuzzer_state_free(FuzzerState* state) {
+	if (state == NULL) return;
+
+	fuzzer_pattern_clear(&state->pattern);
+	g_free(state);
+}
+
+/* Decodes the next character of a string, treating invalid bytes as characters of their own */
+static inline gunichar fuzzer_next_char(const gchar** str) {
+	const guchar* p = (const guchar*) *str;
+	gunichar c;
+
+	if (*p < 0x80) {
+		*str += 1;
+		return *p;
+	}
+
+	c = g_utf8_get_char_validated(*str, -1);
+	if (c == (gunichar) -1 || c == (gunichar) -2) {
+		*str += 1;
+		return *p;
+	}
+
+	*str = g_utf8_next_char(*str);
+	return c;
+}
+
+/* Looks up the mask of a character of the text */
+static inline const guint64* fuzzer_pattern_get_mask(const FuzzerPattern* pattern, gunichar c) {
+	gsize i;
+
+	if (c < 128) return pattern->masks + pattern->ascii_index[c] * pattern->n_words;
+
+	for (i = 0; i < pattern->n_wide_chars; ++i) {
+		if (pattern->wide_chars[i] == c) return pattern->masks + pattern->wide_index[i] * pattern->n_words;
+	}
+
+	return pattern->masks + FUZZER_NO_MATCH * pattern->n_words;
+}
+
+/* Gets the mask index of a pattern character, adding a new mask if needed */
+static guint16 fuzzer_pattern_add_char(FuzzerPattern* pattern, gunichar c) {
+	gsize i;
+
+	if (c < 128) {
+		if (pattern->ascii_index[c] == FUZZER_NO_MATCH) pattern->ascii_index[c] = pattern->n_masks++;
+		return pattern->ascii_index[c];
+	}
+
+	for (i = 0; i < pattern->n_wide_chars; ++i) {
+		if (pattern->wide_chars[i] == c) return pattern->wide_index[i];
+	}
+
+	pattern->wide_chars[pattern->n_wide_chars] = c;
+	pattern->wide_index[pattern->n_wide_chars] = pattern->n_masks++;
+	pattern->n_wide_chars++;
+
+	return pattern->wide_index[pattern->n_wide_chars - 1];
+}
+
+/* Compiles the masks for a pattern, unless they are already compiled for it */
+static void fuzzer_pattern_compile(FuzzerPattern* pattern, const gchar* text, gint max_distance) {
+	const gchar* p;
+	gsize length, words, i;
+
+	if (pattern->pattern != NULL && pattern->max_distance == max_distance && strcmp(pattern->pattern, text) == 0) return;
+
+	g_free(pattern->pattern);
+	pattern->pattern = g_strdup(text);
+	pattern->max_distance = max_distance;
+
+	length = 0;
+	for (p = text; *p != '\0'; ++length) fuzzer_next_char(&p);
+
+	pattern->valid = length < G_MAXUINT16; // Error: pattern too long
+	if (!pattern->valid) return;
+
+	words = length / FUZZER_WORD_BITS + 1; /* One extra bit for the match state */
+
+	/* Grow the buffers if the pattern needs more room than the previous ones */
+	if (length > pattern->pattern_capacity) {
+		pattern->wide_chars = g_renew(gunichar, pattern->wide_chars, length);
+		pattern->wide_index = g_renew(guint16, pattern->wide_index, length);
+		pattern->pattern_capacity = length;
+	}
+
+	if ((length + 1) * words > pattern->masks_capacity) {
+		pattern->masks_capacity = (length + 1) * words;
+		pattern->masks = g_renew(guint64, pattern->masks, pattern->masks_capacity);
+	}
+
+	if ((gsize) (max_distance + 1) * words > pattern->bits_capacity) {
+		pattern->bits_capacity = (max_distance + 1) * words;
+		pattern->bit_array = g_renew(guint64, pattern->bit_array, pattern->bits_capacity);
+	}
+
+	if ((gsize) (max_distance + 1) > pattern->carries_capacity) {
+		pattern->carries_capacity = max_distance + 1;
+		pattern->carries = g_renew(guint64, pattern->carries, pattern->carries_capacity);
+	}
+
+	pattern->pattern_length = length;
+	pattern->n_words = words;
+	pattern->n_wide_chars = 0;
+	pattern->n_masks = 1;
+	memset(pattern->ascii_index, FUZZER_NO_MATCH, sizeof(pattern->ascii_index));
+
+	/* Every mask starts out as all ones, and has the bits of its character cleared */
+	for (i = 0; i < (length + 1) * words; ++i) pattern->masks[i] = ~G_GUINT64_CONSTANT(0);
+
+	for (i = 0, p = text; *p != '\0'; ++i) {
+		guint16 index = fuzzer_pattern_add_char(pattern, fuzzer_next_char(&p));
+		pattern->masks[index * words + i / FUZZER_WORD_BITS] &= ~(G_GUINT64_CONSTANT(1) << (i % FUZZER_WORD_BITS));
+	}
+}
+
+/* Scores a text against a pattern that fits in a single word */
+static gint fuzzer_pattern_score_word(FuzzerPattern* pattern, const gchar* text) {
+	guint64* bits = pattern->bit_array;
+	guint64 match_bit = G_GUINT64_CONSTANT(1) << pattern->pattern_length;
+	gint max_distance = pattern->max_distance;
+	gsize i;
+	gint d;
+
+	/* Initialize the bit arrays */
+	for (d = 0; d <= max_distance; ++d) bits[d] = ~G_GUINT64_CONSTANT(1);
+
+	/* Calculating the score */
+
+	for (i = 0; *text != '\0'; ++i) {
+		guint64 mask = *fuzzer_pattern_get_mask(pattern, fuzzer_next_char(&text));
+
+		/* Update the bit arrays */
+		guint64 old_Rd1 = bits[0];
+
+		bits[0] = (bits[0] | mask) << 1;
+
+		for (d = 1; d <= max_distance; ++d) {
+			guint64 tmp = bits[d];
+
+			/* Only look for substitutions */
+			bits[d] = (old_Rd1 & (bits[d] | mask)) << 1;
+			old_Rd1 = tmp;
+		}
+
+		if (0 == (bits[max_distance] & match_bit)) {
+			return (gint) i - (gint) pattern->pattern_length + 1;
+		}
+	}
+
+	return -1;
+}
+
+/* Scores a text against a pattern that needs bitsets of multiple words */
+static gint fuzzer_pattern_score_words(FuzzerPattern* pattern, const gchar* text) {
+	const guint64* mask;
+	guint64* bits = pattern->bit_array;
+	guint64* carries = pattern->carries;
+	gsize words = pattern->n_words;
+	gsize match_word = pattern->pattern_length / FUZZER_WORD_BITS;
+	guint64 match_bit = G_GUINT64_CONSTANT(1) << (pattern->pattern_length % FUZZER_WORD_BITS);
+	gint max_distance = pattern->max_distance;
+	gsize i, w;
+	gint d;
+
+	/* Initialize the bit arrays */
+	for (d = 0; d <= max_distance; ++d) {
+		bits[d * words] = ~G_GUINT64_CONSTANT(1);
+		for (w = 1; w < words; ++w) bits[d * words + w] = ~G_GUINT64_CONSTANT(0);
+	}
+
+	/* Calculating the score */
+
+	for (i = 0; *text != '\0'; ++i) {
+		mask = fuzzer_pattern_get_mask(pattern, fuzzer_next_char(&text));
+
+		for (d = 0; d <= max_distance; ++d) carries[d] = 0;
+
+		/* Update the bit arrays one word at a time, carrying the shifted out bit */
+		for (w = 0; w < words; ++w) {
+			guint64 old_Rd1 = bits[w];
+			guint64 value = old_Rd1 | mask[w];
+
+			bits[w] = (value << 1) | carries[0];
+			carries[0] = value >> (FUZZER_WORD_BITS - 1);
+
+			for (d = 1; d <= max_distance; ++d) {
+				guint64 tmp = bits[d * words + w];
+
+				/* Only look for substitutions */
+				value = old_Rd1 & (tmp | mask[w]);
+				bits[d * words + w] = (value << 1) | carries[d];
+				carries[d] = value >> (FUZZER_WORD_BITS - 1);
+				old_Rd1 = tmp;
+			}
+		}
+
+		if (0 == (bits[max_distance * words + match_word] & match_bit)) {
+			return (gint) i - (gint) pattern->pattern_length + 1;
+		}
+	}
+
+	return -1;
+}
+
+/* Scores a text against a compiled pattern */
+static inline gint fuzzer_pattern_score(FuzzerPattern* pattern, const gchar* text) {
+	if (!pattern->valid) return -1;
+	if (pattern->pattern_length == 0) return 0; // Pattern is empty
+
+	if (pattern->n_words == 1) return fuzzer_pattern_score_word(pattern, text);
+
+	return fuzzer_pattern_score_words(pattern, text);
+}
+
+/**
+ * fuzzer_state_get_score:
+ * @state: a #FuzzerState
  * @text: the text to compare to
  * @pattern: the text being used to search
  * @max_distance: the maximum distance between the strings to still be considered equal
@@ -20,58 +313,108 @@
  * bit for each element of the pattern. Then it is able to do most of the
  * work with bitwise operations, which are extremely fast.
  *
+ * Both strings are compared by Unicode character, so they should already
+ * be casefolded. Patterns longer than a machine word are matched using
+ * bitsets of multiple words.
+ *
+ * The masks of the pattern are only rebuilt when @pattern or @max_distance
+ * differ from the previous call, so scoring many texts against the same
+ * pattern does not allocate.
+ *
  * Adapted from here: https://www.programmingalgorithms.com/algorithm/fuzzy-bitap-algorithm/
  *
- * Return value: a score based on the closeness of the texts
+ * Return value: the character offset of the match in @text, or -1 if there is no match
  */
-gint fuzzer_get_fuzzy_score(const gchar* text, const gchar* pattern, gint max_distance) {
-	gint result = -1;
-	gint pattern_length;
-	guint64* bit_array = NULL;
-	guint64 pattern_mask[CHAR_MAX + 1];
-	gint i, d;
-
+gint fuzzer_state_get_score(FuzzerState* state, const gchar* text, const gchar* pattern, gint max_distance) {
+	g_return_val_if_fail(state != NULL, -1);
 	g_return_val_if_fail(text != NULL, -1);
 	g_return_val_if_fail(pattern != NULL, -1);
+	g_return_val_if_fail(max_distance >= 0, -1);
 
-	pattern_length = strlen(pattern);
+	if (*pattern == '\0') return 0; // Pattern is empty
 
-	if (g_strcmp0(pattern, "") == 0) return 0; // Pattern is empty
-	if (pattern_length > 31) return -1;		   // Error: pattern too long
+	fuzzer_pattern_compile(&state->pattern, pattern, max_distance);
 
-	/* Initialize the bit array */
-	bit_array = (guint64*) malloc((max_distance + 1) * sizeof(*bit_array));
-	for (i = 0; i <= max_distance; ++i) bit_array[i] = ~1;
+	return fuzzer_pattern_score(&state->pattern, text);
+}
 
-	/* Initialize the pattern masks */
-	for (i = 0; i <= 127; ++i) pattern_mask[i] = ~0;
+/**
+ * fuzzer_compile_pattern:
+ * @pattern: the text being used to search
+ * @max_distance: the maximum distance between the strings to still be considered equal
+ *
+ * Compiles the Bitap masks for a search pattern once, so that it can be
+ * scored against many texts with fuzzer_score_many().
+ *
+ * Return value: (transfer full): a new #FuzzerPattern
+ */
+FuzzerPattern* fuzzer_compile_pattern(const gchar* pattern, gint max_distance) {
+	FuzzerPattern* compiled;
 
-	for (i = 0; i < pattern_length; ++i) pattern_mask[pattern[i]] &= ~(1UL << i);
+	g_return_val_if_fail(pattern != NULL, NULL);
+	g_return_val_if_fail(max_distance >= 0, NULL);
 
-	/* Calculating the score */
+	compiled = g_new0(FuzzerPattern, 1);
+	fuzzer_pattern_compile(compiled, pattern, max_distance);
 
-	for (i = 0; text[i] != '\0'; ++i) {
-		/* Update the bit arrays */
-		guint64 old_Rd1 = bit_array[0];
+	return compiled;
+}
 
-		bit_array[0] |= pattern_mask[text[i]];
-		bit_array[0] <<= 1;
+/**
+ * fuzzer_pattern_free:
+ * @pattern: a #FuzzerPattern
+ *
+ * Frees a compiled pattern and all of its buffers.
+ */
+void fuzzer_pattern_free(FuzzerPattern* pattern) {
+	if (pattern == NULL) return;
 
-		for (d = 1; d <= max_distance; ++d) {
-			guint64 tmp = bit_array[d];
+	fuzzer_pattern_clear(pattern);
+	g_free(pattern);
+}
 
-			/* Only look for substitutions */
-			bit_array[d] = (old_Rd1 & (bit_array[d] | pattern_mask[text[i]])) << 1;
-			old_Rd1 = tmp;
-		}
+/**
+ * fuzzer_score_many:
+ * @pattern: a #FuzzerPattern
+ * @corpus: a buffer of nul-terminated, casefolded texts
+ * @offsets: (array length=n_texts): the byte offsets of the texts to score in @corpus
+ * @n_texts: the number of texts to score
+ * @scores: (array length=n_texts) (out caller-allocates): the scores of the texts
+ *
+ * Fuzzily matches a compiled pattern against many texts in one pass.
+ *
+ * The texts are read from one contiguous buffer, so scoring a whole
+ * candidate set only walks memory forward and never allocates. See
+ * fuzzer_state_get_score() for the meaning of the scores.
+ */
+void fuzzer_score_many(FuzzerPattern* pattern, const gchar* corpus, const guint* offsets, gsize n_texts, gint* scores) {
+	gsize i;
 
-		if (0 == (bit_array[max_distance] & (1UL << pattern_length))) {
-			result = (i - pattern_length) + 1;
-			break;
-		}
-	}
+	g_return_if_fail(pattern != NULL);
+	g_return_if_fail(n_texts == 0 || (corpus != NULL && offsets != NULL && scores != NULL));
+
+	for (i = 0; i < n_texts; ++i) scores[i] = fuzzer_pattern_score(pattern, corpus + offsets[i]);
+}
+
+/**
+ * fuzzer_get_fuzzy_score:
+ * @text: the text to compare to
+ * @pattern: the text being used to search
+ * @max_distance: the maximum distance between the strings to still be considered equal
+ *
+ * Fuzzily matches two strings using a per-thread #FuzzerState.
+ *
+ * See fuzzer_state_get_score() for details.
+ *
+ * Return value: the character offset of the match in @text, or -1 if there is no match
+ */
+gint fuzzer_get_fuzzy_score(const gchar* text, const gchar* pattern, gint max_distance) {
+	FuzzerState* state = g_private_get(&shared_state);
 
-	g_free(bit_array);
+	if (state == NULL) {
+		state = fuzzer_state_new();
+		g_private_set(&shared_state, state);
+	}
 
-	return result;
+	return fuzzer_state_get_score(state, text, pattern, max_distance);
 }
@@ -5,8 +5,22 @@
 
 G_BEGIN_DECLS
 
+typedef struct _FuzzerState FuzzerState;
+typedef struct _FuzzerPattern FuzzerPattern;
+
+FuzzerState* fuzzer_state_new(void);
+void fuzzer_state_free(FuzzerState* state);
+gint fuzzer_state_get_score(FuzzerState* state, const gchar* text, const gchar* pattern, gint max_distance);
+
+FuzzerPattern* fuzzer_compile_pattern(const gchar* pattern, gint max_distance);
+void fuzzer_pattern_free(FuzzerPattern* pattern);
+void fuzzer_score_many(FuzzerPattern* pattern, const gchar* corpus, const guint* offsets, gsize n_texts, gint* scores);
+
 gint fuzzer_get_fuzzy_score(const gchar* text, const gchar* pattern, gint max_distance);
 
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuzzerState, fuzzer_state_free)
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuzzerPattern, fuzzer_pattern_free)
+
 G_END_DECLS
 
 #endif
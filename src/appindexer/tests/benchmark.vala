@@ -0,0 +1,212 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+/**
+ * Benchmarks for the appindexer's fuzzy matching and relevancy ranking.
+ *
+ * Scores corpora of 1k to 10k application names in several scripts, and
+ * reports the cost of a single fuzzy score in the batched matcher, as well
+ * as the latency from a keystroke to a ranked list of applications.
+ *
+ * The applications are not in the AppIndex, so the ranking goes through
+ * RelevancyService's per-application scoring rather than the batch.
+ */
+namespace Budgie.Benchmarks {
+	const int[] CORPUS_SIZES = { 1000, 5000, 10000 };
+
+	/* Search terms for the batched matcher, from short to long */
+	const string[] TERMS = { "t", "te", "term", "termnal", "text editor", "libreoffice writer" };
+
+	/* Terms that are typed one character at a time for the ranking latency */
+	const string[] TYPED_TERMS = { "terminal", "firefox", "über", "терминал" };
+
+	/* Names of real applications, in a few locales */
+	const string[] REAL_NAMES = {
+		"Firefox", "Web Browser", "Terminal", "Text Editor", "Files", "Calculator", "Settings",
+		"LibreOffice Writer", "LibreOffice Calc", "LibreOffice Impress", "GNU Image Manipulation Program",
+		"Visual Studio Code", "Archive Manager", "Disks", "Disk Usage Analyzer", "System Monitor",
+		"Software", "Videos", "Rhythmbox", "Thunderbird Mail", "Document Viewer", "Image Viewer",
+		"Screenshot", "Fonts", "Characters", "Weather", "Clocks", "Maps", "Contacts", "Calendar",
+		"Dateien", "Taschenrechner", "Einstellungen", "Bildbetrachter", "Übersicht", "Systemüberwachung",
+		"Fichiers", "Calculatrice", "Paramètres", "Visionneur d'images", "Éditeur de texte",
+		"Файлы", "Терминал", "Калькулятор", "Параметры", "Текстовый редактор", "Системный монитор",
+		"ファイル", "端末", "電卓", "設定", "テキストエディター", "システムモニター",
+	};
+
+	/* Syllables that synthetic names are made of, per script */
+	const string[] LATIN_SYLLABLES = { "ka", "te", "ri", "mo", "lu", "sen", "dor", "vix", "pla", "qua", "net", "web", "edit", "view" };
+	const string[] ACCENTED_SYLLABLES = { "ké", "tè", "rï", "mö", "lü", "señ", "dør", "vîx", "plà", "çà", "ße", "ñet" };
+	const string[] CYRILLIC_SYLLABLES = { "ка", "те", "ри", "мо", "лу", "сен", "дор", "вик", "пла", "тер", "мин", "ал" };
+	const string[] CJK_SYLLABLES = { "端", "末", "電", "卓", "設", "定", "画", "像", "文", "書", "音", "楽" };
+
+	string[] synthetic_names(string[] syllables, int count, uint32 seed) {
+		var rand = new Rand.with_seed(seed);
+		string[] names = {};
+
+		for (int i = 0; i < count; i++) {
+			var name = new StringBuilder();
+			int words = rand.int_range(1, 4);
+			for (int w = 0; w < words; w++) {
+				if (w > 0) name.append_c(' ');
+				int parts = rand.int_range(1, 4);
+				for (int p = 0; p < parts; p++) {
+					name.append(syllables[rand.int_range(0, syllables.length)]);
+				}
+			}
+			names += name.str;
+		}
+
+		return names;
+	}
+
+	string[] real_names(int count) {
+		string[] names = {};
+		for (int i = 0; i < count; i++) {
+			unowned var name = REAL_NAMES[i % REAL_NAMES.length];
+			// Only the first copy of every name keeps it as is
+			names += (i < REAL_NAMES.length) ? name : "%s %d".printf(name, i / REAL_NAMES.length);
+		}
+		return names;
+	}
+
+	string[] create_corpus(string kind, int size) {
+		switch (kind) {
+			case "latin":
+				return synthetic_names(LATIN_SYLLABLES, size, 1);
+			case "accented":
+				return synthetic_names(ACCENTED_SYLLABLES, size, 2);
+			case "cyrillic":
+				return synthetic_names(CYRILLIC_SYLLABLES, size, 3);
+			case "cjk":
+				return synthetic_names(CJK_SYLLABLES, size, 4);
+			default:
+				return real_names(size);
+		}
+	}
+
+	/**
+	 * Measure the cost of a single fuzzy score with the batched matcher.
+	 */
+	void bench_score_many(string corpus_name, string[] names) {
+		var corpus = new ByteArray();
+		uint[] offsets = {};
+		uint8[] terminator = { 0 };
+
+		foreach (unowned var name in names) {
+			offsets += corpus.len;
+			corpus.append(RelevancyService.searchable_string(name).data);
+			corpus.append(terminator);
+		}
+
+		var scores = new int[offsets.length];
+
+		foreach (unowned var term in TERMS) {
+			var pattern = new Fuzzer.Pattern(term.casefold(), 1);
+
+			// Warm up, then take the best of a few runs to keep the noise down
+			pattern.score_many(corpus.data, offsets, scores);
+
+			int64 best = int64.MAX;
+			for (int run = 0; run < 5; run++) {
+				int64 start = get_monotonic_time();
+				pattern.score_many(corpus.data, offsets, scores);
+				best = int64.min(best, get_monotonic_time() - start);
+			}
+
+			print("score_many  %-9s %6d names  %-20s %8.1f ns/score\n",
+				corpus_name,
+				names.length,
+				"'%s'".printf(term),
+				(best * 1000.0) / offsets.length
+			);
+		}
+	}
+
+	Application create_application(string name, int index) {
+		var keyfile = new KeyFile();
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_TYPE, KeyFileDesktop.TYPE_APPLICATION);
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_NAME, name);
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_EXEC, "true");
+
+		var app = new Application.without_icon_check(new DesktopAppInfo.from_keyfile(keyfile));
+		app.desktop_id = "benchmark-%d.desktop".printf(index);
+		return app;
+	}
+
+	/**
+	 * Measure the time from a keystroke to a ranked list of applications,
+	 * the way the menu filters and sorts its entries.
+	 */
+	void bench_ranking(string corpus_name, string[] names) {
+		Application[] apps = {};
+		for (int i = 0; i < names.length; i++) {
+			apps += create_application(names[i], i);
+		}
+
+		var service = new RelevancyService();
+
+		foreach (unowned var term in TYPED_TERMS) {
+			int64 total = 0;
+			int64 worst = 0;
+			int keystrokes = term.char_count();
+
+			for (int i = 1; i <= keystrokes; i++) {
+				var typed = term.substring(0, term.index_of_nth_char(i));
+				int64 start = get_monotonic_time();
+
+				var relevant = new Gee.ArrayList<Application>();
+				foreach (var app in apps) {
+					service.update_relevancy(app, typed);
+					if (service.is_app_relevant(app)) {
+						relevant.add(app);
+					}
+				}
+
+				relevant.sort((a, b) => {
+					int sc1 = service.get_score(a);
+					int sc2 = service.get_score(b);
+					if (sc1 != sc2) return sc1 < sc2 ? -1 : 1;
+					return a.name.collate(b.name);
+				});
+
+				int64 elapsed = get_monotonic_time() - start;
+				total += elapsed;
+				worst = int64.max(worst, elapsed);
+			}
+
+			print("ranking     %-9s %6d names  %-20s %8.1f us/keystroke (worst %d us)\n",
+				corpus_name,
+				names.length,
+				"'%s'".printf(term),
+				(double) total / keystrokes,
+				(int) worst
+			);
+		}
+
+		service.reset();
+	}
+}
+
+int main(string[] args) {
+	Intl.setlocale(LocaleCategory.ALL, "");
+
+	string[] kinds = { "real", "latin", "accented", "cyrillic", "cjk" };
+
+	foreach (var size in Budgie.Benchmarks.CORPUS_SIZES) {
+		foreach (unowned var kind in kinds) {
+			var names = Budgie.Benchmarks.create_corpus(kind, size);
+			Budgie.Benchmarks.bench_score_many(kind, names);
+			Budgie.Benchmarks.bench_ranking(kind, names);
+		}
+	}
+
+	return 0;
+}
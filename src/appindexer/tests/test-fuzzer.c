@@ -0,0 +1,139 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include "fuzzer.h"
+
+/* Long enough that the pattern needs bitsets of more than one word */
+#define LONG_TEXT "the quick brown fox jumps over the lazy dog while the cat sleeps on the warm mat"
+
+typedef struct {
+	const gchar* text;
+	const gchar* pattern;
+	gint expected;
+} FuzzerCase;
+
+/*
+ * Known scores with a maximum distance of 1. Changing any of these changes
+ * the order of search results in the menu and the run dialog.
+ */
+static const FuzzerCase golden_cases[] = {
+	{ "firefox", "fire", 0 },
+	{ "firefox", "fox", 4 },
+	{ "firefox", "fx", 0 },
+	{ "web browser", "browser", 4 },
+	{ "web browser", "brwser", -1 },
+	{ "web browser", "browsr", 4 },
+	{ "terminal", "term", 0 },
+	{ "terminal", "trm", 1 },
+	{ "gnome terminal", "term", 6 },
+	{ "files", "fils", 0 },
+	{ "files", "", 0 },
+	{ "calculator", "calc", 0 },
+	{ "calculator", "clac", -1 },
+	{ "libreoffice writer", "writer", 12 },
+	{ "text editor", "edit", 5 },
+	{ "settings", "xyz", -1 },
+	{ "gimp", "gmp", 1 },
+	{ "le café noir", "café", 3 },
+	{ "le cafe noir", "café", 3 },
+	{ "übersicht", "über", 0 },
+	{ "терминал", "терм", 0 },
+	{ "консоль", "кансоль", 0 },
+	{ LONG_TEXT, "quick brown fox jumps over the lazy dog while the cat sleeps on the", 4 },
+	{ LONG_TEXT, "quick brown fox jumps over the lazy cog while the cat sleeps on the", 4 },
+	{ LONG_TEXT, "quick brown fax jumps over the lazy cog while the cat sleeps on the", -1 },
+};
+
+static void test_state_golden(void) {
+	g_autoptr(FuzzerState) state = fuzzer_state_new();
+	gsize i;
+
+	for (i = 0; i < G_N_ELEMENTS(golden_cases); ++i) {
+		const FuzzerCase* c = &golden_cases[i];
+		gint score = fuzzer_state_get_score(state, c->text, c->pattern, 1);
+
+		if (score != c->expected) {
+			g_test_message("'%s' in '%s': expected %d, got %d", c->pattern, c->text, c->expected, score);
+		}
+		g_assert_cmpint(score, ==, c->expected);
+	}
+}
+
+static void test_score_many_golden(void) {
+	gsize i, j;
+
+	/* Score every text of a pattern in one batch, like RelevancyService does */
+	for (i = 0; i < G_N_ELEMENTS(golden_cases); ++i) {
+		g_autoptr(FuzzerPattern) pattern = NULL;
+		g_autoptr(GByteArray) corpus = NULL;
+		g_autoptr(GArray) offsets = NULL;
+		g_autoptr(GArray) expected = NULL;
+		g_autofree gint* scores = NULL;
+		const gchar* text = golden_cases[i].pattern;
+
+		/* Only handle every pattern once */
+		for (j = 0; j < i && g_strcmp0(golden_cases[j].pattern, text) != 0; ++j);
+		if (j < i) continue;
+
+		corpus = g_byte_array_new();
+		offsets = g_array_new(FALSE, FALSE, sizeof(guint));
+		expected = g_array_new(FALSE, FALSE, sizeof(gint));
+
+		for (j = i; j < G_N_ELEMENTS(golden_cases); ++j) {
+			guint offset = corpus->len;
+
+			if (g_strcmp0(golden_cases[j].pattern, text) != 0) continue;
+
+			g_byte_array_append(corpus, (const guint8*) golden_cases[j].text, strlen(golden_cases[j].text) + 1);
+			g_array_append_val(offsets, offset);
+			g_array_append_val(expected, golden_cases[j].expected);
+		}
+
+		pattern = fuzzer_compile_pattern(text, 1);
+		scores = g_new0(gint, offsets->len);
+		fuzzer_score_many(pattern, (const gchar*) corpus->data, (const guint*) offsets->data, offsets->len, scores);
+
+		for (j = 0; j < offsets->len; ++j) {
+			g_assert_cmpint(scores[j], ==, g_array_index(expected, gint, j));
+		}
+	}
+}
+
+static void test_state_reuse(void) {
+	g_autoptr(FuzzerState) state = fuzzer_state_new();
+
+	/* Recompiling for a longer and then a shorter pattern must not keep stale masks */
+	g_assert_cmpint(fuzzer_state_get_score(state, "terminal", "term", 1), ==, 0);
+	g_assert_cmpint(fuzzer_state_get_score(state, LONG_TEXT, "quick brown fox jumps over the lazy dog while the cat sleeps on the", 1), ==, 4);
+	g_assert_cmpint(fuzzer_state_get_score(state, "terminal", "trm", 1), ==, 1);
+	g_assert_cmpint(fuzzer_state_get_score(state, "terminal", "trm", 0), ==, -1);
+}
+
+static void test_score_many_empty(void) {
+	g_autoptr(FuzzerPattern) pattern = fuzzer_compile_pattern("term", 1);
+
+	/* Nothing to score, and nothing to write */
+	fuzzer_score_many(pattern, NULL, NULL, 0, NULL);
+}
+
+int main(int argc, char** argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/fuzzer/state/golden", test_state_golden);
+	g_test_add_func("/fuzzer/state/reuse", test_state_reuse);
+	g_test_add_func("/fuzzer/score-many/golden", test_score_many_golden);
+	g_test_add_func("/fuzzer/score-many/empty", test_score_many_empty);
+
+	return g_test_run();
+}
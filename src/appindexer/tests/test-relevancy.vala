@@ -0,0 +1,151 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+/**
+ * Golden ranking tests for RelevancyService.
+ *
+ * These run against a fixed set of applications, with the XDG directories
+ * pointed at an empty tree so that nothing installed on the system is
+ * indexed. Changing any of the expected rankings changes what users see
+ * in the menu and the run dialog.
+ */
+namespace Budgie.Tests {
+	/* Desktop ID, name, generic name, and keywords */
+	const string[] APPLICATIONS = {
+		"firefox.desktop|Firefox|Web Browser|Internet;WWW;Browser;Web;",
+		"org.gnome.Terminal.desktop|Terminal|Terminal Emulator|shell;prompt;command;commandline;cmd;",
+		"org.gnome.TextEditor.desktop|Text Editor|Text Editor|text;editor;notepad;plain;",
+		"org.gnome.Nautilus.desktop|Files|File Manager|folder;manager;explore;disk;filesystem;",
+		"org.gnome.Calculator.desktop|Calculator||calculation;arithmetic;scientific;financial;",
+		"libreoffice-writer.desktop|LibreOffice Writer|Word Processor|Text;Letter;Fax;Document;",
+		"code.desktop|Visual Studio Code|Text Editor|vscode;",
+		"gimp.desktop|GNU Image Manipulation Program|Image Editor|GIMP;graphic;design;illustration;painting;",
+		"org.gnome.Settings.desktop|Settings||Preferences;Settings;",
+		"org.gnome.FileRoller.desktop|Archive Manager||zip;tar;extract;unpack;",
+		"org.example.Uebersicht.desktop|Übersicht||Überblick;Dashboard;",
+		"org.example.Terminal.ru.desktop|Терминал||консоль;",
+	};
+
+	/* Search term, and the relevant applications in order with their scores */
+	const string[] RANKINGS = {
+		"fire|firefox.desktop:0 org.gnome.Nautilus.desktop:1 org.gnome.Settings.desktop:3 libreoffice-writer.desktop:7",
+		"term|org.gnome.Terminal.desktop:0 firefox.desktop:2",
+		"text|org.gnome.TextEditor.desktop:0 libreoffice-writer.desktop:1 code.desktop:1",
+		"edit|org.gnome.TextEditor.desktop:1 code.desktop:5 gimp.desktop:6",
+		"file|org.gnome.Nautilus.desktop:0 firefox.desktop:1 libreoffice-writer.desktop:7",
+		"calc|org.gnome.Calculator.desktop:0",
+		"Calc|org.gnome.Calculator.desktop:0",
+		"writer|libreoffice-writer.desktop:11",
+		"imag|gimp.desktop:1",
+		"manager|org.gnome.Nautilus.desktop:1 org.gnome.FileRoller.desktop:7",
+		"über|org.example.Uebersicht.desktop:0",
+		"терм|org.example.Terminal.ru.desktop:0",
+		"консол|org.example.Terminal.ru.desktop:1",
+		"setings|",
+		"brwser|",
+	};
+
+	Application create_application(string fixture) {
+		var fields = fixture.split("|");
+
+		var keyfile = new KeyFile();
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_TYPE, KeyFileDesktop.TYPE_APPLICATION);
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_NAME, fields[1]);
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_COMMENT, "Golden test application");
+		keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_EXEC, "true");
+		keyfile.set_string(KeyFileDesktop.GROUP, "Keywords", fields[3]);
+		if (fields[2] != "") {
+			keyfile.set_string(KeyFileDesktop.GROUP, KeyFileDesktop.KEY_GENERIC_NAME, fields[2]);
+		}
+
+		// There is no icon theme without a display, so don't check the icon
+		var app = new Application.without_icon_check(new DesktopAppInfo.from_keyfile(keyfile));
+		app.desktop_id = fields[0];
+		return app;
+	}
+
+	Application[] create_applications() {
+		Application[] apps = {};
+		foreach (unowned var fixture in APPLICATIONS) {
+			apps += create_application(fixture);
+		}
+		return apps;
+	}
+
+	/**
+	 * Rank the applications the same way the menu does: relevant ones only,
+	 * by score, and by name when the scores are equal.
+	 */
+	string rank(RelevancyService service, Application[] apps, string term) {
+		var relevant = new Gee.ArrayList<Application>();
+		foreach (var app in apps) {
+			service.update_relevancy(app, term);
+			if (service.is_app_relevant(app)) {
+				relevant.add(app);
+			}
+		}
+
+		relevant.sort((a, b) => {
+			int sc1 = service.get_score(a);
+			int sc2 = service.get_score(b);
+			if (sc1 != sc2) return sc1 < sc2 ? -1 : 1;
+			return strcmp(a.name, b.name);
+		});
+
+		string[] ranking = {};
+		foreach (var app in relevant) {
+			ranking += "%s:%d".printf(app.desktop_id, service.get_score(app));
+		}
+		return string.joinv(" ", ranking);
+	}
+
+	void test_golden_rankings() {
+		var service = new RelevancyService();
+		var apps = create_applications();
+
+		foreach (unowned var golden in RANKINGS) {
+			var fields = golden.split("|");
+			var ranking = rank(service, apps, fields[0]);
+			if (ranking != fields[1]) {
+				Test.message("'%s': expected '%s', got '%s'", fields[0], fields[1], ranking);
+			}
+			assert_cmpstr(ranking, CompareOperator.EQ, fields[1]);
+		}
+	}
+
+	void test_incremental_typing() {
+		var service = new RelevancyService();
+		var apps = create_applications();
+
+		// Typing a term one character at a time must end up with the same
+		// ranking as searching for it directly, whatever was cached on the way
+		foreach (unowned var golden in RANKINGS) {
+			var fields = golden.split("|");
+			unowned string term = fields[0];
+			string ranking = "";
+
+			for (int i = 1; i <= term.char_count(); i++) {
+				ranking = rank(service, apps, term.substring(0, term.index_of_nth_char(i)));
+			}
+
+			assert_cmpstr(ranking, CompareOperator.EQ, fields[1]);
+		}
+	}
+}
+
+int main(string[] args) {
+	Test.init(ref args);
+
+	Test.add_func("/relevancy/golden", Budgie.Tests.test_golden_rankings);
+	Test.add_func("/relevancy/incremental", Budgie.Tests.test_incremental_typing);
+
+	return Test.run();
+}
@@ -10,13 +10,57 @@
  */
 
 namespace Budgie {
+#if HAVE_PIDFD_OPEN
+	/* The number of pidfd_open(2) differs between ABIs, so take it from the C library */
+	[CCode (cname = "SYS_pidfd_open", cheader_filename = "sys/syscall.h")]
+	private extern const long SYS_PIDFD_OPEN;
+
+	[CCode (cname = "syscall", cheader_filename = "unistd.h")]
+	private extern long linux_syscall(long number, ...);
+#endif
+
+	/**
+	* A process that was launched from a desktop file
+	*/
+	private class LaunchedProcess {
+		public string desktop_file;
+		/* Start time of the process, so reused PIDs can be told apart */
+		public uint64 start_time;
+		/* Order in which processes were added, used to evict the oldest */
+		public uint64 sequence;
+		public int pidfd = -1;
+		public uint watch_id = 0;
+
+		~LaunchedProcess() {
+			if (watch_id != 0) {
+				Source.remove(watch_id);
+			}
+
+			if (pidfd >= 0) {
+				try {
+					FileUtils.close(pidfd);
+				} catch (FileError e) {
+					warning("Failed to close pidfd: %s", e.message);
+				}
+			}
+		}
+	}
+
 	public class AppSystem : GLib.Object {
+		/* Maximum number of launched processes to remember */
+		const uint MAX_LAUNCHED_PROCESSES = 512;
+
+		/* Maximum number of parents to walk through when resolving a process */
+		const int MAX_PARENT_DEPTH = 16;
+
 		HashTable<string?,string?> startupids = null;
 		HashTable<string?,string?> simpletons = null;
 		HashTable<string?,DesktopAppInfo?> desktops = null;
 		/* Mapping of based TryExec to desktop ID */
 		HashTable<string?,string?> exec_cache = null;
-		HashTable<int64?,string?> pid_cache = null;
+		/* Mapping of PIDs to the desktop file they were launched from */
+		HashTable<int64?,LaunchedProcess> pid_cache = null;
+		uint64 launch_sequence = 0;
 		AppInfoMonitor? monitor = null;
 
 		bool invalidated = false;
@@ -36,7 +80,7 @@ namespace Budgie {
 			simpletons["gnome-twitch"] = "com.vinszent.gnometwitch";
 			simpletons["anoise.py"] = "anoise";
 
-			pid_cache = new HashTable<int64?,string?>(str_hash, str_equal);
+			pid_cache = new HashTable<int64?,LaunchedProcess>(int64_hash, int64_equal);
 
 			Bus.@get.begin(BusType.SESSION, null, (obj, res) => {
 				try {
@@ -81,10 +125,127 @@ namespace Budgie {
 				return;
 			}
 
-			pid_cache.insert(pid, desktop_file);
+			remember_process(pid, desktop_file);
 			app_launched(desktop_file);
 		}
 
+		/**
+		* Remember which desktop file a process was launched from.
+		*
+		* The entry is dropped as soon as the process exits if the kernel
+		* supports pidfds, otherwise it is validated against /proc lazily.
+		*/
+		private void remember_process(int64 pid, string desktop_file) {
+			uint64 start_time;
+			int64 ppid;
+			if (!read_proc_stat(pid, out ppid, out start_time)) {
+				// The process is already gone
+				return;
+			}
+
+			// Make room for the new process
+			if (pid_cache.size() >= MAX_LAUNCHED_PROCESSES && !(pid in pid_cache)) {
+				prune_processes();
+			}
+
+			var process = new LaunchedProcess() {
+				desktop_file = desktop_file,
+				start_time = start_time,
+				sequence = launch_sequence++,
+			};
+
+#if HAVE_PIDFD_OPEN
+			int pidfd = (int) linux_syscall(SYS_PIDFD_OPEN, (long) pid, (long) 0);
+			if (pidfd >= 0) {
+				process.pidfd = pidfd;
+				// A pidfd becomes readable when the process exits. The watch is
+				// removed along with the entry, so it always belongs to this one.
+				process.watch_id = Unix.fd_add(pidfd, IOCondition.IN, (fd, condition) => {
+					unowned var current = pid_cache.lookup(pid);
+					if (current != null) {
+						current.watch_id = 0;
+						pid_cache.remove(pid);
+					}
+					return Source.REMOVE;
+				});
+			}
+#endif
+
+			pid_cache.insert(pid, process);
+		}
+
+		/**
+		* Remove dead processes from the PID cache, and the oldest ones
+		* if it is still full.
+		*/
+		private void prune_processes() {
+			int64 oldest_pid = 0;
+			uint64 oldest_sequence = uint64.MAX;
+
+			var iter = HashTableIter<int64?,LaunchedProcess>(pid_cache);
+			unowned int64? pid;
+			unowned LaunchedProcess process;
+			while (iter.next(out pid, out process)) {
+				if (!is_process_alive(pid, process)) {
+					iter.remove();
+				} else if (process.sequence < oldest_sequence) {
+					oldest_sequence = process.sequence;
+					oldest_pid = pid;
+				}
+			}
+
+			if (pid_cache.size() >= MAX_LAUNCHED_PROCESSES && oldest_sequence != uint64.MAX) {
+				pid_cache.remove(oldest_pid);
+			}
+		}
+
+		/**
+		* Check if a remembered process is still running, and is not a new
+		* process that reused the PID.
+		*/
+		private static bool is_process_alive(int64 pid, LaunchedProcess process) {
+			uint64 start_time;
+			int64 ppid;
+			if (!read_proc_stat(pid, out ppid, out start_time)) {
+				return false;
+			}
+
+			return start_time == process.start_time;
+		}
+
+		/**
+		* Read the parent PID and start time of a process from /proc.
+		*
+		* Returns: false if the process doesn't exist
+		*/
+		private static bool read_proc_stat(int64 pid, out int64 ppid, out uint64 start_time) {
+			ppid = 0;
+			start_time = 0;
+
+			string contents;
+			try {
+				FileUtils.get_contents("/proc/" + pid.to_string() + "/stat", out contents);
+			} catch (FileError e) {
+				return false;
+			}
+
+			// The command name can contain spaces, so start after it
+			int end = contents.last_index_of_char(')');
+			if (end < 0 || end + 2 >= contents.length) {
+				return false;
+			}
+
+			// The fields after the name start at the state, the third field
+			var fields = contents.substring(end + 2).split(" ");
+			if (fields.length < 20) {
+				return false;
+			}
+
+			ppid = int64.parse(fields[1]);
+			start_time = uint64.parse(fields[19]);
+			return true;
+		}
+
 		/**
 		* We lazily check if at some point we became invalidated. In most cases
 		* a package operation or similar modified a desktop file, i.e. making it
@@ -133,11 +294,40 @@ namespace Budgie {
 			}
 		}
 
+		/**
+		* Get the desktop file that a process was launched from.
+		*/
 		public DesktopAppInfo? query_by_pid(int64 pid) {
-			if (pid in pid_cache) {
-				string filename = pid_cache[pid];
-				DesktopAppInfo? info = new DesktopAppInfo.from_filename(filename);
-				return info;
+			var process = pid_cache.lookup(pid);
+			if (process == null) return null;
+
+			if (process.pidfd >= 0 || is_process_alive(pid, process)) {
+				return new DesktopAppInfo.from_filename(process.desktop_file);
+			}
+
+			// The process exited, and the PID may have been reused
+			pid_cache.remove(pid);
+			return null;
+		}
+
+		/**
+		* Get the desktop file of the closest ancestor of a process that
+		* was launched from one.
+		*
+		* This is a guess: a program started from a terminal resolves to
+		* the terminal, so only use it when nothing else matched.
+		*/
+		public DesktopAppInfo? query_by_ancestor_pid(int64 pid) {
+			for (int depth = 0; depth < MAX_PARENT_DEPTH && pid > 1; depth++) {
+				uint64 start_time;
+				int64 ppid;
+				if (!read_proc_stat(pid, out ppid, out start_time)) {
+					break;
+				}
+				pid = ppid;
+
+				var info = query_by_pid(pid);
+				if (info != null) return info;
 			}
 
 			return null;
@@ -190,9 +380,9 @@ namespace Budgie {
 				}
 			}
 
-			/* See if the pid associated with the window is in our pid cache */
+			/* See if the process of the window was launched from a desktop file */
 			DesktopAppInfo? pid_info = query_by_pid(pid);
-			if (pid_info != null) return query_by_pid(pid);
+			if (pid_info != null) return pid_info;
 
 			/* Next, attempt to get the application based on the GtkApplication ID */
 			DesktopAppInfo? desktops_by_xid = query_by_xid(xid);
@@ -227,6 +417,10 @@ namespace Budgie {
 				}
 			}
 
+			/* Maybe it was started by an application we launched */
+			DesktopAppInfo? ancestor_info = query_by_ancestor_pid(pid);
+			if (ancestor_info != null) return ancestor_info;
+
 			/* IDK. Sorry. */
 			return null;
 		}
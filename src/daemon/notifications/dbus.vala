@@ -106,9 +106,6 @@
 	public class Server : Object {
 		private const string BUDGIE_PANEL_SCHEMA = "com.solus-project.budgie-panel";
 
-		private const string APPLICATION_SCHEMA = "org.gnome.desktop.notifications.application";
-		private const string APPLICATION_PREFIX = "/org/gnome/desktop/notifications/application";
-
 		/** Spacing between notification popups */
 		private const int BUFFER_ZONE = 0;
 		/** Spacing between the first notification and the edge of the screen */
@@ -122,6 +119,7 @@
 		private RavenProxy raven { get; private set; default = null; }
 		private HashTable<uint32, Popup> popups;
 		private Settings panel_settings { private get; private set; default = null; }
+		private RateLimiter rate_limiter;
 
 		private uint32 latest_popup_id { private get; private set; default = 0; }
 		private int32 latest_popup_y;
@@ -137,6 +135,12 @@
 
 			this.popups = new HashTable<uint32, Popup>(direct_hash, direct_equal);
 			this.panel_settings = new Settings(BUDGIE_PANEL_SCHEMA);
+
+			this.rate_limiter = new RateLimiter();
+			this.panel_settings.bind("notification-rate-limit", this.rate_limiter, "rate", SettingsBindFlags.GET);
+			this.panel_settings.bind("notification-rate-burst", this.rate_limiter, "burst", SettingsBindFlags.GET);
+			this.panel_settings.bind("notification-flood-window", this.rate_limiter, "window", SettingsBindFlags.GET);
+			this.rate_limiter.flood_summary.connect(this.on_flood_summary);
 		}
 
 		[DBus (visible=false)]
@@ -232,6 +236,33 @@
 		) throws DBusError, IOError {
 			var id = (replaces_id != 0 ? replaces_id : ++notif_id);
 
+			// Drop notifications from applications that send too many, before doing
+			// any work for them. Critical notifications always get through, and so
+			// do updates to a popup that is still showing, like progress updates.
+			unowned Variant? urgency = hints.lookup("urgency");
+			bool critical = urgency != null && urgency.is_of_type(VariantType.BYTE) && (NotificationPriority) urgency.get_byte() == NotificationPriority.URGENT;
+			bool replacing = replaces_id != 0 && this.popups.contains(replaces_id);
+			if (!critical && !replacing && !this.rate_limiter.allow(app_name, app_icon, hints)) {
+				this.NotificationClosed(id, NotificationCloseReason.EXPIRED);
+				return id;
+			}
+
+			return this.handle_notification(id, app_name, app_icon, summary, body, actions, hints, expire_timeout);
+		}
+
+		/**
+		 * Show a notification and pass it on to Raven.
+		 */
+		private uint32 handle_notification(
+			uint32 id,
+			string app_name,
+			string app_icon,
+			string summary,
+			string body,
+			string[] actions,
+			HashTable<string, Variant> hints,
+			int32 expire_timeout
+		) throws DBusError, IOError {
 			// The spec says that an expiry_timeout of 0 means that the
 			// notification should never expire. That doesn't really make
 			// sense for our implementation however, since this only handles
@@ -241,38 +272,19 @@
 
 			var notification = new Notification(id, app_name, app_icon, summary, body, actions, hints, expires);
 
-			string settings_app_name = app_name;
 			bool should_show = true; // Default to showing notification
 
-			// If this notification has a desktop entry in the hints,
-			// set the app name to get the settings for to it.
-			if ("desktop-entry" in hints) {
-				var desktop_entry = hints.lookup("desktop-entry");
-				if (desktop_entry != null) {
-					settings_app_name = desktop_entry.get_string().replace(".", "-").down(); // This is necessary because Notifications application-children change . to - as well
-				}
-			}
-
 			// Get the application settings
-			var schema = SettingsSchemaSource.get_default().lookup(APPLICATION_SCHEMA, true);
-			if (schema == null) {
-				warning("Application notification schema '%s' not found", APPLICATION_SCHEMA);
-				return id;
-			}
-
-			var app_notification_settings = new Settings.full(
-				schema,
-				null,
-				"%s/%s/".printf(APPLICATION_PREFIX, settings_app_name)
-			);
+			var app_notification_settings = NotificationSettingsCache.get_default().lookup(app_name, hints);
+			if (app_notification_settings == null) return id;
 
 			// Check if notifications are enabled for this app
-			if (!app_notification_settings.get_boolean("enable")) {
+			if (!app_notification_settings.enable) {
 				return id;
 			}
 
 			var should_notify = !this.dispatcher.get_do_not_disturb() || notification.urgency == NotificationPriority.URGENT;
-			should_show = app_notification_settings.get_boolean("show-banners") && // notification popups for this app are enabled
+			should_show = app_notification_settings.show_banners && // notification popups for this app are enabled
 							!this.dispatcher.notifications_paused && // notifications aren't paused, e.g. no fullscreen apps
 							(this.popups.size() < MAX_POPUPS_SHOWN || notification.urgency == NotificationPriority.URGENT); // below the number of max popups, or the noti is critical
 
@@ -297,7 +309,7 @@
 				return id;
 			}
 
-			var show_body_text = app_notification_settings.get_boolean("force-expanded");
+			var show_body_text = app_notification_settings.force_expanded;
 
 			// Add a new notification popup if we should show one
 			// If there is already a popup with this ID, replace it
@@ -454,10 +466,28 @@
 			}
 		}
 
+		/**
+		 * Shows a single notification in place of the ones an application
+		 * sent over its rate limit.
+		 */
+		private void on_flood_summary(string app_name, string app_icon, Variant? desktop_entry, uint count) {
+			var hints = new HashTable<string, Variant>(str_hash, str_equal);
+			if (desktop_entry != null) hints.insert("desktop-entry", desktop_entry);
+
+			// translators: Shown in place of notifications an application sent too quickly. %u is the number of notifications, and %s is the name of the application
+			var summary = ngettext("%u more notification from %s", "%u more notifications from %s", count).printf(count, app_name);
+
+			try {
+				this.handle_notification(++notif_id, app_name, app_icon, summary, "", {}, hints, -1);
+			} catch (Error e) {
+				warning("Unable to show notification summary for '%s': %s", app_name, e.message);
+			}
+		}
+
 		/**
 		 * Performs a bunch of checks and plays a sound if all checks pass.
 		 */
-		private void maybe_play_sound(Notification notification, bool notify, bool should_show, Settings settings) {
+		private void maybe_play_sound(Notification notification, bool notify, bool should_show, AppNotificationSettings settings) {
 			unowned Variant? variant = null;
 
 			// Check if notification sounds are suppressed for this notification
@@ -472,7 +502,7 @@
 			if (!notification.app_info.get_boolean("X-GNOME-UsesNotifications")) return;
 
 			// Check if sound alerts are enabled for this appllication, or if we should not notify or notification is not shown
-			if (!settings.get_boolean("enable-sound-alerts") || !notify || !should_show) return;
+			if (!settings.enable_sound_alerts || !notify || !should_show) return;
 
 			// Default sound name
 			string? sound_name = "dialog-information";
@@ -0,0 +1,144 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie.Notifications {
+	/**
+	 * The token bucket of a single application.
+	 */
+	private class NotificationBucket {
+		public double tokens;
+		public int64 last_refill;
+
+		/* Notifications dropped since the last summary, and what to show the summary with */
+		public uint suppressed = 0;
+		public string app_icon = "";
+		public Variant? desktop_entry = null;
+		public uint flush_id = 0;
+
+		public NotificationBucket(double tokens, int64 now) {
+			this.tokens = tokens;
+			this.last_refill = now;
+		}
+	}
+
+	/**
+	 * Per-application rate limiting for incoming notifications.
+	 *
+	 * Every application gets a token bucket that holds up to `burst`
+	 * notifications and refills at `rate` notifications per minute.
+	 * Notifications that arrive while the bucket is empty are dropped
+	 * and counted, and `window` seconds after the first one was dropped
+	 * a single `flood_summary` is emitted for all of them.
+	 */
+	public class RateLimiter : Object {
+		/** Maximum number of applications to track at once. */
+		private const uint MAX_BUCKETS = 256;
+
+		/** Notifications per minute each application may send, or 0 to disable limiting. */
+		public uint rate { get; set; default = 30; }
+
+		/** Number of notifications an application may send in a burst, at least 1. */
+		public uint burst { get; set; default = 10; }
+
+		/** Seconds to collect dropped notifications for before summarizing them. */
+		public uint window { get; set; default = 10; }
+
+		private HashTable<string, NotificationBucket> buckets;
+
+		/**
+		 * Emitted once the aggregation window has passed for an application
+		 * that had notifications dropped.
+		 */
+		public signal void flood_summary(string app_name, string app_icon, Variant? desktop_entry, uint count);
+
+		construct {
+			this.buckets = new HashTable<string, NotificationBucket>(str_hash, str_equal);
+		}
+
+		/**
+		 * Take a token for a notification from an application.
+		 *
+		 * Returns: true if the notification should be handled, or false
+		 * if it was dropped and will be included in a summary
+		 */
+		public bool allow(string app_name, string app_icon, HashTable<string, Variant> hints) {
+			if (this.rate == 0) return true;
+
+			var now = get_monotonic_time();
+
+			unowned var bucket = this.buckets.lookup(app_name);
+			if (bucket == null) {
+				if (this.buckets.size() >= MAX_BUCKETS) this.prune(now);
+
+				var new_bucket = new NotificationBucket(this.get_burst(), now);
+				this.buckets.insert(app_name, new_bucket);
+				bucket = new_bucket;
+			}
+
+			this.refill(bucket, now);
+
+			if (bucket.tokens >= 1.0) {
+				bucket.tokens -= 1.0;
+				return true;
+			}
+
+			bucket.suppressed++;
+			bucket.app_icon = app_icon;
+			bucket.desktop_entry = hints.lookup("desktop-entry");
+
+			if (bucket.flush_id == 0) {
+				var name = app_name;
+				bucket.flush_id = Timeout.add_seconds(uint.max(this.window, 1), () => {
+					this.flush(name);
+					return Source.REMOVE;
+				});
+			}
+
+			return false;
+		}
+
+		/* A bucket that holds no tokens would drop every notification */
+		private uint get_burst() {
+			return uint.max(this.burst, 1);
+		}
+
+		private void refill(NotificationBucket bucket, int64 now) {
+			var elapsed = (double) (now - bucket.last_refill) / TimeSpan.MINUTE;
+			bucket.tokens = double.min(this.get_burst(), bucket.tokens + elapsed * this.rate);
+			bucket.last_refill = now;
+		}
+
+		private void flush(string app_name) {
+			unowned var bucket = this.buckets.lookup(app_name);
+			if (bucket == null) return;
+
+			bucket.flush_id = 0;
+
+			var count = bucket.suppressed;
+			bucket.suppressed = 0;
+
+			if (count > 0) this.flood_summary(app_name, bucket.app_icon, bucket.desktop_entry, count);
+		}
+
+		/**
+		 * Forget applications whose buckets have refilled completely, since
+		 * they are in the same state as an application we haven't seen.
+		 */
+		private void prune(int64 now) {
+			this.buckets.foreach_remove((name, bucket) => {
+				if (bucket.flush_id != 0) return false;
+
+				this.refill(bucket, now);
+				return bucket.tokens >= this.get_burst();
+			});
+		}
+	}
+}
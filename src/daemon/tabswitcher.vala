@@ -49,9 +49,13 @@ namespace Budgie {
 		private uint64 activation_timestamp;
 		private Xfw.Application? application;
 		private DesktopAppInfo? info;
+		private ulong icon_theme_id = 0;
 		public string id;
 		public string title;
 
+		/** The link of this widget in the switcher's recency queue. */
+		public unowned List<unowned TabSwitcherWidget>? recency_link = null;
+
 		public unowned Xfw.Window? window = null;
 
 		public signal void closed(TabSwitcherWidget widget);
@@ -80,6 +84,9 @@ namespace Budgie {
 			halign = Gtk.Align.CENTER;
 			valign = Gtk.Align.CENTER;
 
+			// Shown up front so that showing the switcher only has to map it
+			show_all();
+
 			window.state_changed.connect((changed_mask, new_state) => {
 				if (
 					(Xfw.WindowState.ACTIVE in changed_mask) &&
@@ -91,22 +98,49 @@ namespace Budgie {
 			});
 
 			window.closed.connect(() => closed(this));
-			application.icon_changed.connect(set_icon);
-			window.icon_changed.connect(set_icon);
+			// The application outlives its windows, so connect methods that are
+			// disconnected along with this widget rather than closures holding it
+			application.icon_changed.connect(on_application_icon_changed);
+			window.icon_changed.connect(on_window_icon_changed);
 			window.name_changed.connect(set_title);
 			window.workspace_changed.connect(() => workspace_changed());
+
+			icon_theme_id = Budgie.IconCache.get_default().theme_changed.connect(set_icon);
+			destroy.connect(() => {
+				SignalHandler.disconnect(Budgie.IconCache.get_default(), icon_theme_id);
+			});
+		}
+
+		private void on_application_icon_changed() {
+			Budgie.IconCache.get_default().invalidate(application);
+			set_icon();
+		}
+
+		private void on_window_icon_changed() {
+			Budgie.IconCache.get_default().invalidate(window);
+			set_icon();
 		}
 
 		private void set_icon() {
+			var icon_cache = Budgie.IconCache.get_default();
 			Icon? info_icon = info != null ? info.get_icon() : null;
 
 			if (info_icon != null) {
+				// Leave themed icons to GTK, so symbolic ones are recolored for the style
 				image.set_from_gicon(info_icon, Gtk.IconSize.DIALOG);
 				return;
 			}
 
-			Pixbuf? windowing_app_icon = application != null ? application.get_icon(Gtk.IconSize.DIALOG, Gtk.IconSize.DIALOG) : null;
-			Pixbuf? window_icon = window.get_icon(Gtk.IconSize.DIALOG, Gtk.IconSize.DIALOG);
+			Pixbuf? windowing_app_icon = null;
+			if (application != null) {
+				windowing_app_icon = icon_cache.lookup(application, Gtk.IconSize.DIALOG, Gtk.IconSize.DIALOG, () => {
+					return application.get_icon(Gtk.IconSize.DIALOG, Gtk.IconSize.DIALOG);
+				});
+			}
+
+			Pixbuf? window_icon = icon_cache.lookup(window, Gtk.IconSize.DIALOG, Gtk.IconSize.DIALOG, () => {
+				return window.get_icon(Gtk.IconSize.DIALOG, Gtk.IconSize.DIALOG);
+			});
 			image.set_from_pixbuf(windowing_app_icon ?? window_icon);
 		}
 
@@ -136,12 +170,16 @@ namespace Budgie {
 
 		private Gdk.Monitor primary_monitor;
 
-		private List<string?> recency = null;
+		// Most recently used first. The window box keeps its children in the same order.
+		private Queue<unowned TabSwitcherWidget> recency = null;
 		private HashTable<string?,TabSwitcherWidget?> ids = null;
 
 		private GLib.Settings? settings = null;
 		private bool show_all_windows = false;
 
+		private uint visible_children = 0;
+		private uint sizing_id = 0;
+
 		/**
 		* Construct a new TabSwitcherWindow
 		*/
@@ -151,7 +189,7 @@ namespace Budgie {
 
 		construct {
 			app_system = new Budgie.AppSystem();
-			recency = new List<string?>();
+			recency = new Queue<unowned TabSwitcherWidget>();
 			ids = new HashTable<string?,TabSwitcherWidget?>(str_hash, str_equal);
 
 			window_box.set_selection_mode(SelectionMode.SINGLE);
@@ -178,7 +216,6 @@ namespace Budgie {
 			}
 
 			window_box.set_filter_func(flowbox_filter);
-			window_box.set_sort_func(flowbox_sort);
 
 			set_position(Gtk.WindowPosition.CENTER_ALWAYS);
 
@@ -215,12 +252,16 @@ namespace Budgie {
 		private void add_window(Xfw.Window window) {
 			if (window.is_skip_pager() || window.is_skip_tasklist()) return;
 
-			var window_widget = new TabSwitcherWidget(app_system, window);
-			var id = window_widget.id;
+			var id = ((ulong) window.x11_get_xid()).to_string();
+			if (ids.contains(id)) return;
 
+			var window_widget = new TabSwitcherWidget(app_system, window);
 			ids.insert(id, window_widget);
 
-			if (get_position_in_recency(id) == -1) recency.append(id);
+			// New windows are the least recently used, matching their place at the end of the box.
+			// Inserting applies the filter to the new child, so the rest don't need to be re-filtered.
+			recency.push_tail(window_widget);
+			window_widget.recency_link = recency.peek_tail_link();
 			window_box.insert(window_widget, -1);
 
 			window_widget.window_activated.connect(set_window_as_activated);
@@ -229,12 +270,10 @@ namespace Budgie {
 
 			window_widget.workspace_changed.connect(() => {
 				window_box.invalidate_filter(); // Re-filter, maybe window is now on active workspace
+				queue_update_sizing();
 			});
 
-			window_box.invalidate_filter(); // Re-filter
-			window_box.invalidate_sort(); // Re-sort
-
-			update_sizing();
+			queue_update_sizing();
 		}
 
 		private bool flowbox_filter(FlowBoxChild box_child) {
@@ -248,36 +287,19 @@ namespace Budgie {
 			return window_on_active_workspace(tab.window);
 		}
 
-		private int flowbox_sort(FlowBoxChild child1, FlowBoxChild child2) {
-			TabSwitcherWidget? tab1 =  child1 as TabSwitcherWidget;
-			TabSwitcherWidget? tab2 =  child2 as TabSwitcherWidget;
-			int64 pos1 = get_position_in_recency(tab1.id);
-			int64 pos2 = get_position_in_recency(tab2.id);
-			return pos1 < pos2 ? -1 : 1;
-		}
-
+		/**
+		* Get the number of windows that would be shown in the switcher
+		*/
 		public uint get_visible_children() {
-			uint visible_children = 0;
-			foreach (var child in window_box.get_children()) {
-				var tab = child as TabSwitcherWidget;
-				if (show_all_windows || window_on_active_workspace(tab.window)) visible_children++;
+			// Make sure the switcher is up to date before it is shown
+			if (sizing_id != 0) {
+				Source.remove(sizing_id);
+				update_sizing();
 			}
 
 			return visible_children;
 		}
 
-		// get_position_in_recency will get the position in recency
-		// You might think "hey, but List has an index function, just use that!"
-		// No, because for whatever reason it fails at such a basic task
-		private int64 get_position_in_recency(string id) {
-			for (int i = 0; i < recency.length(); i++) {
-				var val = recency.nth_data((uint) i);
-				if (val == id) return i;
-			}
-
-			return -1;
-		}
-
 		/**
 		* Make the current selection the active window
 		*/
@@ -326,33 +348,65 @@ namespace Budgie {
 
 		private void remove_window(TabSwitcherWidget? widget) {
 			if (widget == null) return;
+			recency.delete_link(widget.recency_link);
+			widget.recency_link = null;
 			ids.remove(widget.id);
-			window_box.remove(widget);
-			unowned List<string> entries = recency.find_custom(widget.id, strcmp);
-			recency.remove_link(entries);
-			update_sizing();
+			// Destroying also takes it out of the box, and drops its icon theme handler
+			widget.destroy();
+			queue_update_sizing();
 		}
 
 		private void set_window_as_activated(Xfw.Window window) {
 			string id = ((ulong) window.x11_get_xid()).to_string();
-			unowned List<string> entries = recency.find_custom(id, strcmp);
-			recency.remove_link(entries);
-			recency.prepend(id);
-			window_box.invalidate_sort(); // Re-sort
+			TabSwitcherWidget? widget = ids.get(id);
+			if (widget == null || widget.recency_link == recency.peek_head_link()) return;
+
+			recency.delete_link(widget.recency_link);
+			recency.push_head(widget);
+			widget.recency_link = recency.peek_head_link();
+
+			// Move only the activated child to the front instead of re-sorting the whole box
+			window_box.remove(widget);
+			window_box.insert(widget, 0);
 		}
 
 		private void update_show_all_windows() {
 			if (settings == null) return;
 			show_all_windows = settings.get_boolean(SHOW_ALL_WINDOWS_KEY);
-			window_box.invalidate_sort(); // Re-sort
 			window_box.invalidate_filter(); // Re-filter
-			update_sizing();
+			queue_update_sizing();
+		}
+
+		/**
+		* Update the layout of the switcher once the current batch of
+		* window changes has been handled, so it is ready to be shown
+		*/
+		private void queue_update_sizing() {
+			if (sizing_id != 0) return;
+
+			sizing_id = Idle.add(() => {
+				update_sizing();
+				return Source.REMOVE;
+			});
 		}
 
 		private void update_sizing() {
-			window_box.set_max_children_per_line(get_visible_children().clamp(1, 8));
+			sizing_id = 0;
+
+			visible_children = 0;
+			foreach (var child in window_box.get_children()) {
+				var tab = child as TabSwitcherWidget;
+				if (show_all_windows || window_on_active_workspace(tab.window)) visible_children++;
+			}
+
+			window_box.set_max_children_per_line(visible_children.clamp(1, 8));
 			window_box.queue_resize();
 			queue_resize();
+
+			// Measure while hidden, so the styles and sizes are cached before the first show
+			Gtk.Requisition minimum, natural;
+			get_preferred_size(out minimum, out natural);
+
 			move_switcher();
 		}
 
@@ -378,8 +432,8 @@ namespace Budgie {
 			FlowBoxChild? new_child = null;
 			TabSwitcherWidget? new_widget = null;
 
-			var len = recency.length();
-			int64 id_pos = (widget != null) ? get_position_in_recency(widget.id).clamp(0, len - 1) : 0;
+			var len = recency.length;
+			int64 id_pos = (widget != null) ? ((int64) widget.get_index()).clamp(0, len - 1) : 0;
 
 			for (var i = 0; i < len; i++) {
 				uint64 new_id_pos = 0;
@@ -461,7 +515,7 @@ namespace Budgie {
 
 				switcher_window.move_switcher();
 				switcher_window.focus_item(backwards);
-				switcher_window.show_all();
+				switcher_window.show();
 			}
 
 			public void StopSwitcher() throws DBusError, IOError {
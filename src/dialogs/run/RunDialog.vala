@@ -112,8 +112,9 @@ namespace Budgie {
 			/* Just so I can debug for now */
 			bottom_revealer.set_reveal_child(false);
 
-			/* Create our launcher buttons */
+			/* Create our launcher buttons, and recreate them when the index changes */
 			this.load_buttons();
+			Budgie.AppIndex.get().changed.connect(this.load_buttons);
 
 			setup_window_positioning.begin();
 
@@ -350,8 +351,14 @@ namespace Budgie {
 
 		/**
 		 * Create our launcher buttons from the Budgie AppIndexer.
+		 *
+		 * Any existing buttons are replaced.
 		 */
 		void load_buttons() {
+			foreach (var row in this.app_box.get_children()) {
+				row.destroy();
+			}
+
 			var added = new List<Budgie.Application>();
 			var index = Budgie.AppIndex.get();
 			var categories = index.get_categories();
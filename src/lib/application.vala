@@ -29,6 +29,11 @@ namespace Budgie {
 		public bool dbus_activatable { get; private set; default = false; }
 		public string[] actions { get; private set; }
 
+		/**
+		* The GVariant type of the records created by `to_variant()`.
+		*/
+		public const string VARIANT_TYPE = "(sssssssasasasvbbb)";
+
 		/**
 		* Emitted when the application is launched.
 		*
@@ -45,10 +50,95 @@ namespace Budgie {
 
 		private Switcheroo switcheroo;
 
+		/* The interned entries of categories */
+		private Quark[] category_quarks = {};
+
+		/* The icon from the desktop file, before any fallback was applied */
+		private Icon? desktop_icon = null;
+
 		/**
 		* Create a new application from a `DesktopAppInfo`.
 		*/
 		public Application(DesktopAppInfo app_info) {
+			this.load_app_info(app_info);
+			this.check_icon();
+		}
+
+		/**
+		* Create a new application from a `DesktopAppInfo` without checking
+		* if its icon exists in the icon theme.
+		*
+		* This does not touch GTK, so it is safe to call from a worker
+		* thread. `check_icon()` has to be called from the main thread
+		* before the application is shown.
+		*/
+		public Application.without_icon_check(DesktopAppInfo app_info) {
+			this.load_app_info(app_info);
+		}
+
+		/**
+		* Create a new application from a record created by `to_variant()`.
+		*
+		* This does not touch the desktop file or the icon theme, so it is
+		* cheap enough to restore large numbers of applications at once.
+		* `check_icon()` has to be called from the main thread before the
+		* application is shown.
+		*/
+		public Application.from_variant(Variant data) {
+			this.desktop_id = data.get_child_value(0).get_string();
+			this.name = data.get_child_value(1).get_string();
+			this.description = data.get_child_value(2).get_string();
+			this.exec = nullable_string(data.get_child_value(3));
+			this.desktop_path = nullable_string(data.get_child_value(4));
+			this.categories = nullable_string(data.get_child_value(5));
+			this.category_quarks = intern_categories(this.categories);
+			this.generic_name = nullable_string(data.get_child_value(6));
+			this.keywords = data.get_child_value(7).dup_strv();
+			this.content_types = data.get_child_value(8).dup_strv();
+			this.actions = data.get_child_value(9).dup_strv();
+			this.prefers_default_gpu = data.get_child_value(11).get_boolean();
+			this.should_show = data.get_child_value(12).get_boolean();
+			this.dbus_activatable = data.get_child_value(13).get_boolean();
+
+			this.desktop_icon = Icon.deserialize(data.get_child_value(10).get_variant());
+			if (this.desktop_icon != null) {
+				this.icon = this.desktop_icon;
+			}
+		}
+
+		construct {
+			this.switcheroo = new Switcheroo();
+		}
+
+		/**
+		* Serialize this application into a flat record.
+		*
+		* Unset strings are stored as empty strings. The icon is stored as
+		* it is in the desktop file, so that an icon that is installed later
+		* is picked up by `check_icon()`.
+		*/
+		public Variant to_variant() {
+			var serialized_icon = (this.desktop_icon ?? this.icon).serialize() ?? new Variant.string("application-default-icon");
+
+			return new Variant.tuple({
+				new Variant.string(this.desktop_id),
+				new Variant.string(this.name),
+				new Variant.string(this.description ?? ""),
+				new Variant.string(this.exec ?? ""),
+				new Variant.string(this.desktop_path ?? ""),
+				new Variant.string(this.categories ?? ""),
+				new Variant.string(this.generic_name ?? ""),
+				new Variant.strv(this.keywords ?? new string[0]),
+				new Variant.strv(this.content_types ?? new string[0]),
+				new Variant.strv(this.actions ?? new string[0]),
+				new Variant.variant(serialized_icon),
+				new Variant.boolean(this.prefers_default_gpu),
+				new Variant.boolean(this.should_show),
+				new Variant.boolean(this.dbus_activatable),
+			});
+		}
+
+		private void load_app_info(DesktopAppInfo app_info) {
 			this.name = app_info.get_display_name();
 			this.description = app_info.get_description() ?? name;
 			this.exec = app_info.get_commandline();
@@ -56,6 +146,7 @@ namespace Budgie {
 			this.desktop_path = app_info.get_filename();
 			this.keywords = app_info.get_keywords();
 			this.categories = app_info.get_categories();
+			this.category_quarks = intern_categories(this.categories);
 			this.content_types = app_info.get_supported_types();
 			this.generic_name = app_info.get_generic_name();
 			this.prefers_default_gpu = !app_info.get_boolean("PrefersNonDefaultGPU");
@@ -63,19 +154,59 @@ namespace Budgie {
 			this.dbus_activatable = app_info.get_boolean("DBusActivatable");
 			this.actions = app_info.list_actions();
 
-			// Try to get an icon from the desktop file
-			var desktop_icon = app_info.get_icon();
-			if (desktop_icon != null) {
-				// Make sure we have a usable icon
-				unowned var theme = Gtk.IconTheme.get_default();
-				if (theme.lookup_by_gicon(desktop_icon, 64, Gtk.IconLookupFlags.USE_BUILTIN) != null) {
-					this.icon = desktop_icon;
+			// Take the icon from the desktop file, if it has one
+			this.desktop_icon = app_info.get_icon();
+			if (this.desktop_icon != null) {
+				this.icon = this.desktop_icon;
+			}
+		}
+
+		/**
+		* Make sure that the icon of this application is usable, falling
+		* back to the default application icon if it isn't.
+		*
+		* This must be called from the main thread.
+		*/
+		public void check_icon() {
+			if (this.desktop_icon == null) return;
+
+			unowned var theme = Gtk.IconTheme.get_default();
+			if (theme.lookup_by_gicon(this.desktop_icon, 64, Gtk.IconLookupFlags.USE_BUILTIN) == null) {
+				this.icon = new ThemedIcon.with_default_fallbacks("application-default-icon");
+			} else if (this.icon != this.desktop_icon) {
+				this.icon = this.desktop_icon;
+			}
+		}
+
+		/**
+		* Split a Categories string from a desktop file into quarks.
+		*/
+		private static Quark[] intern_categories(string? categories) {
+			Quark[] quarks = {};
+			if (categories == null) {
+				return quarks;
+			}
+
+			foreach (unowned var category in categories.split(";")) {
+				if (category != "") {
+					quarks += Quark.from_string(category);
 				}
 			}
+
+			return quarks;
 		}
 
-		construct {
-			this.switcheroo = new Switcheroo();
+		private static string? nullable_string(Variant value) {
+			unowned var str = value.get_string();
+			return str != "" ? str : null;
+		}
+
+		/**
+		* Get the interned entries of `categories`, so that they can be
+		* compared without any string operations.
+		*/
+		public unowned Quark[] get_category_quarks() {
+			return this.category_quarks;
 		}
 
 		public AppLaunchContext create_launch_context() {
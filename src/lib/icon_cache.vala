@@ -0,0 +1,221 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie {
+	/**
+	 * Loads an icon when it is not in the cache.
+	 */
+	public delegate Gdk.Pixbuf? IconLoadFunc();
+
+	/**
+	 * A single cached pixbuf.
+	 */
+	private class IconCacheEntry {
+		public string owner;
+		public Gdk.Pixbuf? pixbuf;
+		public uint64 last_used;
+
+		public IconCacheEntry(string owner, Gdk.Pixbuf? pixbuf, uint64 last_used) {
+			this.owner = owner;
+			this.pixbuf = pixbuf;
+			this.last_used = last_used;
+		}
+	}
+
+	/**
+	 * Process-wide cache of icon pixbufs.
+	 *
+	 * Icons are keyed by the object they belong to (or the GIcon they are
+	 * loaded from), the pixel size, and the scale factor, so every panel
+	 * and applet in a process shares one decoded copy of each icon. The
+	 * least recently used icons are dropped once the cache is full, and
+	 * everything is dropped when the icon theme changes.
+	 *
+	 * Pixbufs are always full color, so icons that follow the widget's
+	 * style, like symbolic icons, should be shown from their GIcon instead.
+	 *
+	 * Use `get_default()` to get the shared instance.
+	 */
+	public class IconCache : Object {
+		/** Maximum number of pixbufs kept in the cache. */
+		private const uint MAX_ENTRIES = 256;
+
+		private static IconCache? instance = null;
+
+		private HashTable<string, IconCacheEntry> entries;
+		private GenericSet<string> watched_owners;
+		private uint64 clock = 0;
+		private uint64 n_hits = 0;
+		private uint64 n_misses = 0;
+
+		/** Number of lookups that were served from the cache. */
+		public uint64 hits {
+			get { return this.n_hits; }
+		}
+
+		/** Number of lookups that had to load the icon. */
+		public uint64 misses {
+			get { return this.n_misses; }
+		}
+
+		/** Number of pixbufs currently in the cache. */
+		public uint size {
+			get { return this.entries.size(); }
+		}
+
+		/**
+		 * Emitted after the icon theme changed and every cached icon was
+		 * dropped. Anything showing an icon from the cache should look it
+		 * up again.
+		 */
+		public signal void theme_changed();
+
+		private IconCache() {
+			Object();
+		}
+
+		construct {
+			this.entries = new HashTable<string, IconCacheEntry>(str_hash, str_equal);
+			this.watched_owners = new GenericSet<string>(str_hash, str_equal);
+
+			Gtk.IconTheme.get_default().changed.connect(this.on_icon_theme_changed);
+		}
+
+		/**
+		 * Get the shared icon cache for this process.
+		 */
+		public static unowned IconCache get_default() {
+			if (instance == null) {
+				instance = new IconCache();
+			}
+
+			return instance;
+		}
+
+		/**
+		 * Get the icon belonging to an object, such as a window or an
+		 * application, at the given size and scale.
+		 *
+		 * If the icon is not cached, `load` is called to load it. The
+		 * cached icons are dropped when the object is finalized; call
+		 * `invalidate()` when its icon changes.
+		 */
+		public Gdk.Pixbuf? lookup(Object owner, int size, int scale, IconLoadFunc load) {
+			var owner_key = get_owner_key(owner);
+
+			if (!this.watched_owners.contains(owner_key)) {
+				this.watched_owners.add(owner_key);
+				owner.weak_ref(this.on_owner_finalized);
+			}
+
+			return this.lookup_key(owner_key, size, scale, load);
+		}
+
+		/**
+		 * Get the pixbuf for a GIcon from the current icon theme at the
+		 * given size and scale.
+		 */
+		public Gdk.Pixbuf? lookup_gicon(GLib.Icon icon, int size, int scale) {
+			var name = icon.to_string();
+
+			// Icons that can't be serialized are keyed by their instance instead
+			if (name == null) {
+				return this.lookup(icon, size, scale, () => load_gicon(icon, size, scale));
+			}
+
+			return this.lookup_key("gicon:" + name, size, scale, () => load_gicon(icon, size, scale));
+		}
+
+		/**
+		 * Drop all of the cached icons belonging to an object.
+		 */
+		public void invalidate(Object owner) {
+			var owner_key = get_owner_key(owner);
+			this.entries.foreach_remove((key, entry) => entry.owner == owner_key);
+		}
+
+		/**
+		 * Drop every icon in the cache.
+		 */
+		public void clear() {
+			this.entries.remove_all();
+		}
+
+		private Gdk.Pixbuf? lookup_key(string owner_key, int size, int scale, IconLoadFunc load) {
+			var key = "%s:%d@%d".printf(owner_key, size, scale);
+
+			unowned var entry = this.entries.lookup(key);
+			if (entry != null) {
+				this.n_hits++;
+				entry.last_used = ++this.clock;
+				return entry.pixbuf;
+			}
+
+			this.n_misses++;
+
+			// Failed loads are cached too, so a missing icon isn't looked up on every redraw
+			var pixbuf = load();
+
+			if (this.entries.size() >= MAX_ENTRIES) {
+				this.evict_oldest();
+			}
+
+			this.entries.insert(key, new IconCacheEntry(owner_key, pixbuf, ++this.clock));
+			return pixbuf;
+		}
+
+		private void evict_oldest() {
+			unowned string? oldest_key = null;
+			uint64 oldest = uint64.MAX;
+
+			var iter = HashTableIter<string, IconCacheEntry>(this.entries);
+			unowned string key;
+			unowned IconCacheEntry entry;
+			while (iter.next(out key, out entry)) {
+				if (entry.last_used < oldest) {
+					oldest = entry.last_used;
+					oldest_key = key;
+				}
+			}
+
+			if (oldest_key != null) {
+				this.entries.remove(oldest_key);
+			}
+		}
+
+		private void on_icon_theme_changed() {
+			this.clear();
+			this.theme_changed();
+		}
+
+		private void on_owner_finalized(Object owner) {
+			var owner_key = get_owner_key(owner);
+			this.watched_owners.remove(owner_key);
+			this.entries.foreach_remove((key, entry) => entry.owner == owner_key);
+		}
+
+		private static string get_owner_key(Object owner) {
+			return "object:%p".printf(owner);
+		}
+
+		private static Gdk.Pixbuf? load_gicon(GLib.Icon icon, int size, int scale) {
+			var info = Gtk.IconTheme.get_default().lookup_by_gicon_for_scale(icon, size, scale, Gtk.IconLookupFlags.FORCE_SIZE);
+			if (info == null) return null;
+
+			try {
+				return info.load_icon();
+			} catch (Error e) {
+				warning("Unable to load icon '%s': %s", icon.to_string(), e.message);
+				return null;
+			}
+		}
+	}
+}
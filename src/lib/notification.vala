@@ -61,6 +61,15 @@
 		public Gtk.Image? app_image { get; set; default = null; }
 		public Gtk.Image? image { get; set; default = null; }
 
+		/** The D-Bus type of image data hints. */
+		private const string IMAGE_DATA_TYPE = "(iiibiiay)";
+
+		/** Largest width or height of image data that will be decoded. */
+		private const int MAX_IMAGE_DATA_SIZE = 2048;
+
+		/** The size notification images are shown at. */
+		private const int IMAGE_SIZE = 48;
+
 		private static Regex entity_regex;
 		private static Regex tag_regex;
 
@@ -167,7 +176,7 @@
 					image_found = true;
 				} else if (path.has_prefix("/") || path.has_prefix("file://")) {
 					try {
-						var pixbuf = new Gdk.Pixbuf.from_file_at_size(path, 48, 48);
+						var pixbuf = new Gdk.Pixbuf.from_file_at_size(path, IMAGE_SIZE, IMAGE_SIZE);
 						image = new Gtk.Image.from_pixbuf(pixbuf);
 						image_found = true;
 					} catch (Error e) {
@@ -219,33 +228,74 @@
 			}
 		}
 
-		private Gdk.Pixbuf? decode_image(Variant img) {
+		/**
+		 * Decode the image data from a notification's hints.
+		 *
+		 * The pixel data is used in place instead of being copied, and is
+		 * scaled straight to the size notification images are shown at.
+		 * Images that are malformed or larger than `MAX_IMAGE_DATA_SIZE`
+		 * are ignored.
+		 */
+		private static Gdk.Pixbuf? decode_image(Variant img) {
+			if (!img.is_of_type(new VariantType(IMAGE_DATA_TYPE))) {
+				warning("Ignoring notification image data of type '%s'", img.get_type_string());
+				return null;
+			}
+
 			// Read the image fields
 			int width = img.get_child_value(0).get_int32();
 			int height = img.get_child_value(1).get_int32();
 			int rowstride = img.get_child_value(2).get_int32();
 			bool has_alpha = img.get_child_value(3).get_boolean();
 			int bits_per_sample = img.get_child_value(4).get_int32();
-			// read the raw data
-			unowned uint8[] raw = (uint8[]) img.get_child_value(6).get_data();
+			int channels = img.get_child_value(5).get_int32();
+			var data = img.get_child_value(6);
+
+			if (width <= 0 || height <= 0 || width > MAX_IMAGE_DATA_SIZE || height > MAX_IMAGE_DATA_SIZE) {
+				warning("Ignoring notification image data of size %dx%d", width, height);
+				return null;
+			}
 
-			// rebuild and scale the image
-			var pixbuf = new Gdk.Pixbuf.with_unowned_data(
-				raw,
+			// The last row doesn't have to be padded out to the rowstride
+			uint64 row_size = (uint64) width * channels;
+			if (
+				bits_per_sample != 8 ||
+				channels != (has_alpha ? 4 : 3) ||
+				rowstride <= 0 ||
+				rowstride < row_size ||
+				data.get_size() < (uint64) (height - 1) * rowstride + row_size
+			) {
+				warning("Ignoring malformed notification image data");
+				return null;
+			}
+
+			// Shares the memory of the D-Bus message instead of copying it
+			var bytes = data.get_data_as_bytes();
+
+			var pixbuf = new Gdk.Pixbuf.from_bytes(
+				bytes,
 				Gdk.Colorspace.RGB,
 				has_alpha,
 				bits_per_sample,
 				width,
 				height,
-				rowstride,
-				null
+				rowstride
 			);
 
-			if (height != 48) { // Height isn't 48
-				pixbuf = pixbuf.scale_simple(48, 48, Gdk.InterpType.BILINEAR); // Scale down (or up if it is small)
+			// Scale to the display size in one step, keeping the aspect ratio
+			int scaled_width = IMAGE_SIZE;
+			int scaled_height = IMAGE_SIZE;
+			if (width > height) {
+				scaled_height = int.max(1, height * IMAGE_SIZE / width);
+			} else {
+				scaled_width = int.max(1, width * IMAGE_SIZE / height);
+			}
+
+			if (scaled_width != width || scaled_height != height) {
+				pixbuf = pixbuf.scale_simple(scaled_width, scaled_height, Gdk.InterpType.BILINEAR);
 			}
 
-			return pixbuf.copy();
+			return pixbuf;
 		}
 
 		/**
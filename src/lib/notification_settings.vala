@@ -0,0 +1,169 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie {
+	/**
+	 * The notification settings of a single application.
+	 *
+	 * The flags are kept up to date from the application's settings as
+	 * they change, so reading them never has to go to dconf.
+	 */
+	public class AppNotificationSettings : Object {
+		/** The normalized ID the settings are stored under. */
+		public string settings_id { get; construct; }
+
+		/** Whether notifications from this application are enabled at all. */
+		public bool enable { get; private set; default = true; }
+
+		/** Whether notifications from this application show popups. */
+		public bool show_banners { get; private set; default = true; }
+
+		/** Whether popups from this application always show their body text. */
+		public bool force_expanded { get; private set; default = false; }
+
+		/** Whether notifications from this application can play sounds. */
+		public bool enable_sound_alerts { get; private set; default = true; }
+
+		private Settings settings;
+
+		internal AppNotificationSettings(string settings_id, SettingsSchema schema, string path) {
+			Object(settings_id: settings_id);
+
+			this.settings = new Settings.full(schema, null, path);
+			this.settings.changed.connect(this.on_changed);
+
+			this.enable = this.settings.get_boolean("enable");
+			this.show_banners = this.settings.get_boolean("show-banners");
+			this.force_expanded = this.settings.get_boolean("force-expanded");
+			this.enable_sound_alerts = this.settings.get_boolean("enable-sound-alerts");
+		}
+
+		private void on_changed(string key) {
+			switch (key) {
+				case "enable":
+					this.enable = this.settings.get_boolean(key);
+					break;
+				case "show-banners":
+					this.show_banners = this.settings.get_boolean(key);
+					break;
+				case "force-expanded":
+					this.force_expanded = this.settings.get_boolean(key);
+					break;
+				case "enable-sound-alerts":
+					this.enable_sound_alerts = this.settings.get_boolean(key);
+					break;
+			}
+		}
+	}
+
+	/**
+	 * Process-wide cache of per-application notification settings.
+	 *
+	 * Creating a relocatable settings object for every notification is
+	 * expensive, so the settings of each application are created once
+	 * and looked up by their normalized ID afterwards.
+	 *
+	 * Use `get_default()` to get the shared instance.
+	 */
+	public class NotificationSettingsCache : Object {
+		private const string APPLICATION_SCHEMA = "org.gnome.desktop.notifications.application";
+		private const string APPLICATION_PREFIX = "/org/gnome/desktop/notifications/application";
+
+		/**
+		 * Maximum number of applications to keep settings for. App names
+		 * come from the sender, so this bounds what a misbehaving client
+		 * can make us allocate.
+		 */
+		private const uint MAX_ENTRIES = 256;
+
+		private static NotificationSettingsCache? instance = null;
+
+		private SettingsSchema? schema;
+		private HashTable<string, AppNotificationSettings> entries;
+
+		private NotificationSettingsCache() {
+			Object();
+		}
+
+		construct {
+			this.schema = SettingsSchemaSource.get_default().lookup(APPLICATION_SCHEMA, true);
+			this.entries = new HashTable<string, AppNotificationSettings>(str_hash, str_equal);
+
+			if (this.schema == null) {
+				warning("Application notification schema '%s' not found", APPLICATION_SCHEMA);
+			}
+		}
+
+		/**
+		 * Get the shared notification settings cache for this process.
+		 */
+		public static unowned NotificationSettingsCache get_default() {
+			if (instance == null) {
+				instance = new NotificationSettingsCache();
+			}
+
+			return instance;
+		}
+
+		/**
+		 * Get the ID that the settings for a notification are stored under.
+		 *
+		 * This is the notification's desktop entry if it has one, with dots
+		 * replaced the same way as the notification settings children, or
+		 * the application name otherwise.
+		 */
+		public static string get_settings_id(string app_name, HashTable<string, Variant> hints) {
+			unowned Variant? desktop_entry = hints.lookup("desktop-entry");
+
+			if (desktop_entry != null && desktop_entry.is_of_type(VariantType.STRING)) {
+				return desktop_entry.get_string().replace(".", "-").down();
+			}
+
+			return app_name;
+		}
+
+		/**
+		 * Get the notification settings for a notification.
+		 *
+		 * Returns: the application's settings, or null if the notification
+		 * settings schema is not installed
+		 */
+		public AppNotificationSettings? lookup(string app_name, HashTable<string, Variant> hints) {
+			return this.lookup_id(get_settings_id(app_name, hints));
+		}
+
+		/**
+		 * Get the notification settings stored under a normalized ID.
+		 *
+		 * Returns: the application's settings, or null if the notification
+		 * settings schema is not installed
+		 */
+		public AppNotificationSettings? lookup_id(string settings_id) {
+			if (this.schema == null) return null;
+
+			unowned var settings = this.entries.lookup(settings_id);
+			if (settings != null) return settings;
+
+			if (this.entries.size() >= MAX_ENTRIES) {
+				this.entries.remove_all();
+			}
+
+			var new_settings = new AppNotificationSettings(
+				settings_id,
+				this.schema,
+				"%s/%s/".printf(APPLICATION_PREFIX, settings_id)
+			);
+
+			this.entries.insert(settings_id, new_settings);
+			return new_settings;
+		}
+	}
+}
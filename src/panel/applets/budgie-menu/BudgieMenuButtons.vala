@@ -88,17 +88,6 @@ public class MenuButton : Gtk.Button {
 		get_style_context().add_class("flat");
 	}
 
-	/**
-	 * Check if this item is for a control center panel.
-	 */
-	public bool is_control_center_panel() {
-		var control_center = "budgie-control-center";
-		return (
-			control_center in app.exec &&
-			app.exec.length != control_center.length
-		);
-	}
-
 	private bool hide_toplevel() {
 		this.get_toplevel().hide();
 		return false;
@@ -121,3 +110,39 @@ public class MenuButton : Gtk.Button {
 		}
 	}
 }
+
+/**
+ * Model item for an application shown in a category.
+ *
+ * Everything needed to filter and sort the application list is kept
+ * here, so that buttons only have to be created for visible items.
+ */
+public class MenuEntry : Object {
+	public Budgie.Application app { get; construct; }
+	public Budgie.Category category { get; construct; }
+
+	/** Whether this entry is for a control center panel. */
+	public bool control_center_panel { get; private set; default = false; }
+
+	/** Searchable form of the application name, used for sorting. */
+	public string name_key { get; private set; }
+
+	/** Searchable form of the category name, used for sorting. */
+	public string category_key { get; private set; }
+
+	public MenuEntry(Budgie.Application app, Budgie.Category category) {
+		Object(app: app, category: category);
+	}
+
+	construct {
+		var control_center = "budgie-control-center";
+		this.control_center_panel = (
+			app.exec != null &&
+			control_center in app.exec &&
+			app.exec.length != control_center.length
+		);
+
+		this.name_key = Budgie.RelevancyService.searchable_string(app.name);
+		this.category_key = Budgie.RelevancyService.searchable_string(category.name);
+	}
+}
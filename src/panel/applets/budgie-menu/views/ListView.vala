@@ -29,6 +29,15 @@ public class ApplicationListView : ApplicationView {
 	private Gtk.ScrolledWindow content_scroll;
 	private CategoryButton all_categories;
 
+	/* Every application in every category */
+	private Gee.ArrayList<MenuEntry> entries;
+
+	/* The visible entries, in order, which the application list is bound to */
+	private ListStore visible_entries;
+
+	/* Buttons that have been created for entries, reused across updates */
+	private Gee.HashMap<MenuEntry, MenuButton> entry_buttons;
+
 	public Settings settings { get; construct; default = null; }
 
 	// The current group
@@ -59,6 +68,10 @@ public class ApplicationListView : ApplicationView {
 		this.set_size_request(current_width, current_height);
 		this.icon_size = settings.get_int("menu-icons-size");
 
+		this.entries = new Gee.ArrayList<MenuEntry>();
+		this.visible_entries = new ListStore(typeof(MenuEntry));
+		this.entry_buttons = new Gee.HashMap<MenuEntry, MenuButton>();
+
 		this.categories = new Gtk.Box(Gtk.Orientation.VERTICAL, 0) {
 			margin_top = 3,
 			margin_bottom = 3
@@ -96,6 +109,8 @@ public class ApplicationListView : ApplicationView {
 			height_request = current_height
 		};
 		this.applications.row_activated.connect(this.on_row_activate);
+		// Rows are only created for the entries that pass the filter
+		this.applications.bind_model(this.visible_entries, this.create_entry_widget);
 
 		this.content_scroll = new Gtk.ScrolledWindow(null, null) {
 			overlay_scrolling = true,
@@ -122,10 +137,6 @@ public class ApplicationListView : ApplicationView {
 		this.on_settings_changed("menu-categories-hover");
 		this.on_settings_changed("menu-show-control-center-items");
 
-		// management of our listbox
-		this.applications.set_filter_func(do_filter_list);
-		this.applications.set_sort_func(do_sort_list);
-
 		this.update_sizing();
 	}
 
@@ -176,11 +187,13 @@ public class ApplicationListView : ApplicationView {
 		}
 
 		// Destroy all application items
-		foreach (var child in this.applications.get_children()) {
-			child.destroy();
+		foreach (var button in this.entry_buttons.values) {
+			button.destroy();
 		}
-		this.application_buttons.remove_all();
-		this.control_center_buttons.clear();
+		this.entry_buttons.clear();
+		this.visible_entries.remove_all();
+		this.entries.clear();
+		this.application_entries.remove_all();
 
 		// Destroy all category items
 		this.categories.get_children().foreach((child) => {
@@ -229,33 +242,85 @@ public class ApplicationListView : ApplicationView {
 			btn.show_all();
 			this.categories.pack_start(btn, false); // Add the button
 
-			// Create a button for each app in this category
+			// Create an entry for each app in this category. Buttons
+			// are only created once an entry becomes visible.
 			foreach (var app in category.apps) {
-				var app_btn = new MenuButton(app, category, icon_size);
+				var entry = new MenuEntry(app, category);
+				this.application_entries.insert(app.desktop_id, entry);
+				this.entries.add(entry);
+			}
+		}
+	}
+
+	/**
+	 * Get the button for an entry in the application list, creating it
+	 * if it doesn't exist yet.
+	 */
+	private Gtk.Widget create_entry_widget(Object item) {
+		var entry = item as MenuEntry;
 
-				app_btn.clicked.connect(() => {
-					app.launch();
-					this.app_launched();
-				});
+		var app_btn = this.entry_buttons.get(entry);
+		if (app_btn == null) {
+			app_btn = new MenuButton(entry.app, entry.category, icon_size);
 
-				this.application_buttons.insert(app.desktop_id, app_btn);
-				app_btn.show_all();
-				this.applications.add(app_btn);
+			app_btn.clicked.connect(() => {
+				entry.app.launch();
+				this.app_launched();
+			});
 
-				if (app_btn.is_control_center_panel()) {
-					this.control_center_buttons.add(app_btn);
-				}
-			}
+			this.entry_buttons.set(entry, app_btn);
 		}
+
+		app_btn.show_all();
+		return app_btn;
 	}
 
 	/**
 	 * Invalidate the application headers, filters, and sorting.
+	 *
+	 * The entries are filtered and sorted, and the application list is
+	 * updated to show the result.
 	 */
 	public override void invalidate() {
-		this.applications.invalidate_headers();
-		this.applications.invalidate_filter();
-		this.applications.invalidate_sort();
+		// "disable" categories while searching
+		this.categories.sensitive = this.search_term.strip().length == 0;
+
+		var visible = new Gee.ArrayList<MenuEntry>();
+		foreach (var entry in this.entries) {
+			if (this.do_filter_list(entry)) {
+				visible.add(entry);
+			}
+		}
+		visible.sort(this.do_sort_list);
+
+		// Nothing to do if the list is already showing these entries
+		uint n_items = this.visible_entries.get_n_items();
+		if (n_items == visible.size) {
+			bool same = true;
+			for (uint i = 0; i < n_items && same; i++) {
+				same = this.visible_entries.get_item(i) == visible[(int) i];
+			}
+
+			if (same) {
+				this.applications.invalidate_headers();
+				return;
+			}
+		}
+
+		// Take the buttons out of their rows so that they survive the
+		// rows being destroyed, and can be reused
+		foreach (var row in this.applications.get_children()) {
+			var child = ((Gtk.Bin) row).get_child();
+			if (child != null) {
+				((Gtk.Container) row).remove(child);
+			}
+		}
+
+		Object[] items = new Object[visible.size];
+		for (int i = 0; i < visible.size; i++) {
+			items[i] = visible[i];
+		}
+		this.visible_entries.splice(0, n_items, items);
 	}
 
 	/**
@@ -268,12 +333,8 @@ public class ApplicationListView : ApplicationView {
 		if (rows != null) {
 			selected = rows.data;
 		} else {
-			foreach (var child in this.applications.get_children()) {
-				if (child.get_visible() && child.get_child_visible()) {
-					selected = child as Gtk.ListBoxRow;
-					break;
-				}
-			}
+			// Only visible entries have rows, so the first row is the top result
+			selected = this.applications.get_row_at_index(0);
 		}
 		if (selected == null) {
 			return;
@@ -374,12 +435,19 @@ public class ApplicationListView : ApplicationView {
 		// Just retrieve the category names
 		if (before != null) {
 			child = before.get_child() as MenuButton;
+			if (child == null) {
+				// This row is being replaced, and its button is already taken out
+				before.set_header(null);
+				return;
+			}
 			prev = child.category.name;
 		}
 
 		if (after != null) {
 			child = after.get_child() as MenuButton;
-			next = child.category.name;
+			if (child != null) {
+				next = child.category.name;
+			}
 		}
 
 		// Only add one if we need one!
@@ -399,14 +467,10 @@ public class ApplicationListView : ApplicationView {
 	 * Filter out results in the list according to whatever the current filter is,
 	 * i.e. group based or search based
 	 */
-	private bool do_filter_list(Gtk.ListBoxRow row) {
-		MenuButton child = row.get_child() as MenuButton;
-
+	private bool do_filter_list(MenuEntry child) {
 		// Check if there is a search going on
 		string term = this.search_term.strip();
 		if (term.length > 0) {
-			// "disable" categories while searching
-			this.categories.sensitive = false;
 			// Items must be unique across the search
 			if (this.is_item_dupe(child)) {
 				return false;
@@ -417,14 +481,11 @@ public class ApplicationListView : ApplicationView {
 			return this.relevancy_service.is_app_relevant(child.app);
 		}
 
-		// "enable" categories if not searching
-		this.categories.sensitive = true;
-
 		// We are currently in the "All" category, so show this item
 		if (this.current_category == null) {
 			// Don't show this item if it's a control center panel and
 			// we're set to not show them
-			if (child.is_control_center_panel()) {
+			if (child.control_center_panel) {
 				if (!this.show_control_center_panels) {
 					return false;
 				}
@@ -446,7 +507,7 @@ public class ApplicationListView : ApplicationView {
 		}
 
 		// Don't show this item if it's a control panel and we're not set to show them
-		if (child.is_control_center_panel()) {
+		if (child.control_center_panel) {
 			if (!this.show_control_center_panels) {
 				return false;
 			}
@@ -463,10 +524,7 @@ public class ApplicationListView : ApplicationView {
 	 * If there is an active search, items will be sorted by how well they match the term.
 	 * Otherwise, they will be sorted alphebetically by their name.
 	 */
-	private int do_sort_list(Gtk.ListBoxRow row1, Gtk.ListBoxRow row2) {
-		MenuButton child1 = row1.get_child() as MenuButton;
-		MenuButton child2 = row2.get_child() as MenuButton;
-
+	private int do_sort_list(MenuEntry child1, MenuEntry child2) {
 		string term = this.search_term.strip();
 
 		// Check for an active search
@@ -487,16 +545,12 @@ public class ApplicationListView : ApplicationView {
 		}
 
 		// Only perform category grouping if headers are visible
-		string parentA = Budgie.RelevancyService.searchable_string(child1.category.name);
-		string parentB = Budgie.RelevancyService.searchable_string(child2.category.name);
 		if (child1.category != child2.category && this.headers_visible) {
-			return parentA.collate(parentB);
+			return child1.category_key.collate(child2.category_key);
 		}
 
 		// Two application items, sort by name
-		string nameA = Budgie.RelevancyService.searchable_string(child1.app.name);
-		string nameB = Budgie.RelevancyService.searchable_string(child2.app.name);
-		return nameA.collate(nameB);
+		return child1.name_key.collate(child2.name_key);
 	}
 
 	/**
@@ -14,9 +14,8 @@
  * extend.
  */
 public abstract class ApplicationView : Gtk.Box {
-	/** Mapped id to MenuButton */
-	public HashTable<string,MenuButton?> application_buttons { get; construct set; default = null; }
-	public Gee.ArrayList<MenuButton> control_center_buttons { get; construct set; default = null; }
+	/** Mapped id to the MenuEntry that is shown when results must be unique */
+	public HashTable<string,MenuEntry?> application_entries { get; construct set; default = null; }
 	public string search_term { get; public set; default = ""; }
 	public int icon_size { get; protected set; default = 24; }
 
@@ -29,8 +28,7 @@ public abstract class ApplicationView : Gtk.Box {
 	public signal void app_launched();
 
 	construct {
-		this.application_buttons = new HashTable<string,MenuButton?>(str_hash, str_equal);
-		this.control_center_buttons = new Gee.ArrayList<MenuButton>();
+		this.application_entries = new HashTable<string,MenuEntry?>(str_hash, str_equal);
 		this.relevancy_service = new Budgie.RelevancyService();
 	}
 
@@ -84,19 +82,19 @@ public abstract class ApplicationView : Gtk.Box {
 
 		// Update the relevancy of all apps when
 		// the search term changes
-		foreach (var child in this.application_buttons.get_values()) {
-			this.relevancy_service.update_relevancy(child.app, search_term);
+		foreach (var entry in this.application_entries.get_values()) {
+			this.relevancy_service.update_relevancy(entry.app, search_term);
 		}
 
 		this.invalidate();
 	}
 
 	/**
-	 * Checks if a `MenuButton` already exists in the view.
+	 * Checks if another `MenuEntry` for the same application exists in the view.
 	 */
-	protected bool is_item_dupe(MenuButton? button) {
-		MenuButton? compare_item = this.application_buttons.lookup(button.app.desktop_id);
-		if (compare_item != null && compare_item != button) {
+	protected bool is_item_dupe(MenuEntry? entry) {
+		MenuEntry? compare_item = this.application_entries.lookup(entry.app.desktop_id);
+		if (compare_item != null && compare_item != entry) {
 			return true;
 		}
 		return false;
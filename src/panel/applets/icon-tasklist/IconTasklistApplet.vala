@@ -62,11 +62,11 @@ public class IconTasklistApplet : Budgie.Applet {
 	private Settings settings;
 	private Gtk.Box main_layout;
 
-	private Budgie.ApplicationMatcher matcher;
 
 	private bool lock_icons = false;
 	private bool restrict_to_workspace = false;
 	private bool only_show_pinned = false;
+	private uint popover_idle_timeout = 60;
 
 	private int icon_size = 0;
 	private int panel_size = 0;
@@ -111,6 +111,7 @@ public class IconTasklistApplet : Budgie.Applet {
 		this.on_settings_changed("restrict-to-workspace");
 		this.on_settings_changed("lock-icons");
 		this.on_settings_changed("only-pinned");
+		this.on_settings_changed("popover-idle-timeout");
 
 		this.connect_app_signals();
 
@@ -124,8 +125,6 @@ public class IconTasklistApplet : Budgie.Applet {
 		buttons = new HashTable<string, IconButton>(str_hash, str_equal);
 		main_layout = new Gtk.Box(Gtk.Orientation.HORIZONTAL, 0);
 
-		matcher = new Budgie.ApplicationMatcher();
-
 		/* Initial bootstrap of helpers */
 		windowing = new Budgie.Windowing.Windowing();
 
@@ -157,8 +156,8 @@ public class IconTasklistApplet : Budgie.Applet {
 	}
 
 	private void connect_app_signals() {
-		windowing.active_window_changed.connect_after(on_active_window_changed);
-		windowing.active_workspace_changed.connect_after(update_buttons);
+		// Focus and workspace switches come in bursts, so only update once per frame
+		windowing.windows_changed.connect(on_windows_changed);
 
 		windowing.window_group_added.connect(on_app_opened);
 		windowing.window_group_removed.connect(on_app_closed);
@@ -190,6 +189,12 @@ public class IconTasklistApplet : Budgie.Applet {
 			case "only-pinned":
 				this.only_show_pinned = this.settings.get_boolean(key);
 				break;
+			case "popover-idle-timeout":
+				this.popover_idle_timeout = this.settings.get_uint(key);
+				this.buttons.foreach((id, button) => {
+					button.popover_idle_timeout = this.popover_idle_timeout;
+				});
+				return;
 		}
 
 		this.update_buttons();
@@ -226,26 +231,14 @@ public class IconTasklistApplet : Budgie.Applet {
 			size = 32;
 		}
 
-		var icon_theme = Gtk.IconTheme.get_default();
-		var icon_info = icon_theme.lookup_icon(button.app.icon.to_string(), size, Gtk.IconLookupFlags.USE_BUILTIN);
+		var pixbuf = Budgie.IconCache.get_default().lookup_gicon(button.app.icon, size, 1);
 
-		// Check if icon_info is null (e.g., broken symlink or missing icon)
-		if (icon_info == null) {
+		// Check if the icon couldn't be loaded (e.g., broken symlink or missing icon)
+		if (pixbuf == null) {
 			warning("Unable to find icon: %s", button.app.icon.to_string());
 			return;
 		}
 
-		Gdk.Pixbuf? pixbuf;
-
-		try {
-			pixbuf = icon_info.load_icon();
-		} catch (Error e) {
-			warning("Unable to get Pixbuf from Icon");
-			return;
-		}
-
-		if (pixbuf == null) return;
-
 		var surface = Gdk.cairo_surface_create_from_pixbuf(pixbuf, 1, null);
 
 		Gtk.drag_set_icon_surface(context, surface);
@@ -387,9 +380,10 @@ public class IconTasklistApplet : Budgie.Applet {
 	/**
 	 * Get the application ID for a window group
 	 *
-	 * This method first tries to get the app_id from group.app_info (standard case).
-	 * If that fails or doesn't match any existing buttons, it uses ApplicationMatcher
-	 * to handle non-standard apps like Tilix, jEdit, and snap applications.
+	 * This method first tries to get the app_id from group.app_info, which the
+	 * windowing library resolves once per group. If that doesn't match any
+	 * existing buttons, it asks the shared ApplicationMatcher, which handles
+	 * non-standard apps like Tilix, jEdit, and snap applications.
 	 *
 	 * @param group The window group to get an ID for
 	 * @param application Output parameter set to the Application object if found
@@ -409,15 +403,24 @@ public class IconTasklistApplet : Budgie.Applet {
 		// This handles apps like Tilix (com.gexperts.Tilix.desktop → tilix WM_CLASS),
 		// jEdit (jedit.desktop → org-gjt-sp-jedit-jEdit WM_CLASS),
 		// and snap apps (snap-store_ubuntu-software.desktop → snap-store WM_CLASS)
-		var match_result = matcher.match_window_group(group);
+		// The result of this is cached by the matcher, so it is cheap to ask again
+		var match_result = Budgie.Windowing.ApplicationMatcher.get_default().match_window_group(group);
 
 		if (match_result.matched()) {
+			// The group was already resolved to this application
+			if (application != null && application.desktop_id == match_result.desktop_id) {
+				return match_result.desktop_id;
+			}
+
 			// Create Application from matched desktop ID
-			application = matcher.create_application(match_result.desktop_id);
+			var app_info = new DesktopAppInfo(match_result.desktop_id);
 
-			if (application != null) {
+			if (app_info != null) {
+				application = new Budgie.Application(app_info);
 				return match_result.desktop_id;
 			}
+
+			warning(@"Failed to create DesktopAppInfo for '$(match_result.desktop_id)'");
 		}
 
 		// ultimate fallback - use the group_id as-is
@@ -516,7 +519,17 @@ public class IconTasklistApplet : Budgie.Applet {
 		button.update();
 	}
 
-	private void on_active_window_changed(Xfw.Window? old_active_window, Xfw.Window? new_active_window) {
+	private void on_windows_changed(Budgie.Windowing.WindowChanges changes) {
+		if (changes.active_workspace_changed) {
+			update_buttons();
+		}
+
+		if (changes.active_window_changed) {
+			update_active_window(windowing.get_active_window());
+		}
+	}
+
+	private void update_active_window(Xfw.Window? new_active_window) {
 		foreach (IconButton button in buttons.get_values()) {
 			if (new_active_window != null && button.has_window(new_active_window)) {
 				button.set_active_window(true);
@@ -627,6 +640,7 @@ public class IconTasklistApplet : Budgie.Applet {
 				}
 				break;
 			case Gdk.BUTTON_SECONDARY:
+				button.ensure_popover();
 				manager.show_popover(button);
 				return Gdk.EVENT_STOP;
 			case Gdk.BUTTON_MIDDLE:
@@ -696,6 +710,7 @@ public class IconTasklistApplet : Budgie.Applet {
 
 	private void add_icon_button(string app_id, IconButton button) {
 		add_button(app_id, button); // map app to it's button so that we can update it later on
+		button.popover_idle_timeout = popover_idle_timeout;
 
 		ButtonWrapper wrapper = new ButtonWrapper(button);
 		wrapper.orient = get_orientation();
@@ -99,7 +99,7 @@ public class IconTasklistButtonPopover : Gtk.Popover {
 		};
 
 		if (group != null) {
-			foreach (var window in group.get_windows()) {
+			foreach (unowned var window in group.peek_windows()) {
 				add_window(window);
 			}
 		}
@@ -257,6 +257,8 @@ private class WindowControls : Gtk.Box {
 	private Gtk.Button? minimize_button;
 	private Gtk.Button? return_button;
 
+	private ulong state_changed_id = 0;
+
 	public signal void return_clicked();
 
 	public WindowControls(Xfw.Window window) {
@@ -313,12 +315,20 @@ private class WindowControls : Gtk.Box {
 			return_clicked();
 		});
 
-		window.state_changed.connect((changed_mask, new_state) => {
+		// The window outlives this page, so don't let it keep us alive
+		state_changed_id = window.state_changed.connect((changed_mask, new_state) => {
 			if (Xfw.WindowState.MAXIMIZED in changed_mask) {
 				update_maximize_label();
 			}
 		});
 
+		destroy.connect(() => {
+			if (state_changed_id != 0) {
+				SignalHandler.disconnect(window, state_changed_id);
+				state_changed_id = 0;
+			}
+		});
+
 		update_maximize_label();
 
 		show_all();
@@ -373,6 +383,8 @@ private class WindowItem : Gtk.ListBoxRow {
 	private Gtk.Button? close_button;
 	private Gtk.Button? page_switch_button;
 
+	private ulong name_changed_id = 0;
+
 	public signal void page_switch_clicked();
 
 	public WindowItem(Xfw.Window window) {
@@ -436,8 +448,16 @@ private class WindowItem : Gtk.ListBoxRow {
 
 		show_all();
 
-		window.name_changed.connect(() => {
+		// The window outlives the popover this item is in, so don't let it keep us alive
+		name_changed_id = window.name_changed.connect(() => {
 			name_label.label = window.get_name();
 		});
+
+		destroy.connect(() => {
+			if (name_changed_id != 0) {
+				SignalHandler.disconnect(window, name_changed_id);
+				name_changed_id = 0;
+			}
+		});
 	}
 }
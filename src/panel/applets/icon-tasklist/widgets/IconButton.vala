@@ -29,10 +29,18 @@ public class IconButton : Gtk.ToggleButton {
 	public bool pinned { get; set; default = false; }
 	public bool has_active_window { get; private set; default = false; }
 
+	/**
+	 * Number of seconds after the popover is closed before it is destroyed,
+	 * or 0 to keep it around once it has been built.
+	 */
+	public uint popover_idle_timeout { get; set; default = 60; }
+
 	private Budgie.Windowing.WindowGroup? window_group = null;
 
 	private Icon? icon;
-	private IconTasklistButtonPopover? popover;
+	private IconTasklistButtonPopover? popover = null;
+	private uint popover_timeout_id = 0;
+	private ulong icon_theme_id = 0;
 
 	private Gtk.Allocation definite_allocation;
 	private int target_icon_size = 0;
@@ -75,12 +83,6 @@ public class IconButton : Gtk.ToggleButton {
 
 		icon.get_style_context().add_class("icon");
 
-		popover = new IconTasklistButtonPopover(this, app, window_group) {
-			pinned = this.pinned,
-		};
-
-		popover.bind_property("pinned", this, "pinned", BindingFlags.BIDIRECTIONAL);
-
 		if (app != null) {
 			set_tooltip_text(app.name);
 
@@ -92,11 +94,29 @@ public class IconButton : Gtk.ToggleButton {
 			if (window != null) set_tooltip_text(window.get_name());
 		}
 
-		popover_manager.register_popover(this, popover);
-
 		add(icon);
 
 		size_allocate.connect(on_size_allocate);
+
+		// Window group icons come from the icon cache, so load them again for a new theme
+		icon_theme_id = Budgie.IconCache.get_default().theme_changed.connect(update_icon);
+
+		destroy.connect(() => {
+			if (icon_theme_id != 0) {
+				SignalHandler.disconnect(Budgie.IconCache.get_default(), icon_theme_id);
+				icon_theme_id = 0;
+			}
+
+			if (popover_timeout_id != 0) {
+				Source.remove(popover_timeout_id);
+				popover_timeout_id = 0;
+			}
+
+			if (popover != null) {
+				popover.destroy();
+				popover = null;
+			}
+		});
 	}
 
 	private void on_size_allocate(Gtk.Allocation allocation) {
@@ -117,7 +137,7 @@ public class IconButton : Gtk.ToggleButton {
 
 		// If this button has active windows, set their button geometry
 		if (window_group != null && window_group.has_windows()) {
-			foreach (var win in window_group.get_windows()) {
+			foreach (unowned var win in window_group.peek_windows()) {
 				try {
 					set_window_button_geometry(win);
 				} catch (Error e) {
@@ -220,23 +240,17 @@ public class IconButton : Gtk.ToggleButton {
 		int width = definite_allocation.width;
 		int height = definite_allocation.height;
 
-		List<unowned Xfw.Window> windows;
-
 		// Get the windows in this group, if any
-		if (window_group != null && window_group.has_windows()) {
-			windows = window_group.get_windows();
-		} else {
-			windows = new List<unowned Xfw.Window>();
-		}
+		unowned List<unowned Xfw.Window>? windows = window_group?.peek_windows();
 
 		// No indicators if there are no windows
-		if (windows.is_empty()) return base.draw(ctx);
+		if (windows == null) return base.draw(ctx);
 
 		// If this button does not have any focused windows,
 		// draw the inactive versions of the window indicators
 		if (!get_active()) return draw_inactive(ctx);
 
-		int count = int.min((int) windows.length(), 5);
+		int count = int.min((int) window_group.get_n_windows(), 5);
 
 		// Calculate the spacing between individual indicators
 		int spacing = width % count;
@@ -387,21 +401,15 @@ public class IconButton : Gtk.ToggleButton {
 		int width = definite_allocation.width;
 		int height = definite_allocation.height;
 
-		List<unowned Xfw.Window> windows;
-
 		// Get the windows in this group, if any
-		if (window_group != null && window_group.has_windows()) {
-			windows = window_group.get_windows();
-		} else {
-			windows = new List<unowned Xfw.Window>();
-		}
+		unowned List<unowned Xfw.Window>? windows = window_group?.peek_windows();
 
 		// No windows, no indicators
-		if (windows.is_empty()) {
+		if (windows == null) {
 			return base.draw(ctx);
 		}
 
-		int count = int.min((int) windows.length(), 5);
+		int count = int.min((int) window_group.get_n_windows(), 5);
 
 		// Iterate over the number of windows
 		for (int i = 0; i < count; i++) {
@@ -564,14 +572,19 @@ public class IconButton : Gtk.ToggleButton {
 
 	public void set_window_group(Budgie.Windowing.WindowGroup? window_group) {
 		this.window_group = window_group;
-		popover.group = window_group;
 
-		if (window_group == null) return;
+		if (popover != null) {
+			popover.group = window_group;
 
-		foreach (var window in window_group.get_windows()) {
-			popover.add_window(window);
+			if (window_group != null) {
+				foreach (unowned var window in window_group.peek_windows()) {
+					popover.add_window(window);
+				}
+			}
 		}
 
+		if (window_group == null) return;
+
 		// Set the button's tooltip text to the current (or previous) active window's name.
 		// We look for the last active window in case the panel was restarted or the tasklist
 		// was added to an already-running session with open windows, so that buttons will still
@@ -592,11 +605,12 @@ public class IconButton : Gtk.ToggleButton {
 		});
 
 		window_group.app_icon_changed.connect_after(() => {
+			Budgie.IconCache.get_default().invalidate(window_group.application);
 			update_icon();
 		});
 
 		window_group.window_added.connect((window) => {
-			popover.add_window(window);
+			if (popover != null) popover.add_window(window);
 
 			window.state_changed.connect((changed_mask, new_state) => {
 				if (!(Xfw.WindowState.URGENT in changed_mask)) {
@@ -612,11 +626,59 @@ public class IconButton : Gtk.ToggleButton {
 		});
 
 		window_group.window_removed.connect((window) => {
-			popover.remove_window(window);
+			if (popover != null) popover.remove_window(window);
 			update();
 		});
 	}
 
+	/**
+	 * Build the popover for this button if it doesn't exist yet.
+	 *
+	 * Popovers are only built when they are first opened, and are
+	 * destroyed again once they have been closed for
+	 * `popover_idle_timeout` seconds.
+	 */
+	public void ensure_popover() {
+		if (popover_timeout_id != 0) {
+			Source.remove(popover_timeout_id);
+			popover_timeout_id = 0;
+		}
+
+		if (popover != null) return;
+
+		popover = new IconTasklistButtonPopover(this, app, window_group) {
+			pinned = this.pinned,
+		};
+
+		popover.bind_property("pinned", this, "pinned", BindingFlags.BIDIRECTIONAL);
+		popover.closed.connect(on_popover_closed);
+
+		popover_manager.register_popover(this, popover);
+	}
+
+	private void on_popover_closed() {
+		if (popover_timeout_id != 0) {
+			Source.remove(popover_timeout_id);
+			popover_timeout_id = 0;
+		}
+
+		if (popover_idle_timeout == 0) return;
+
+		popover_timeout_id = Timeout.add_seconds(popover_idle_timeout, () => {
+			popover_timeout_id = 0;
+			destroy_popover();
+			return Source.REMOVE;
+		});
+	}
+
+	private void destroy_popover() {
+		if (popover == null || popover.visible) return;
+
+		popover_manager.unregister_popover(this);
+		popover.destroy();
+		popover = null;
+	}
+
 	public void update() {
 		if (window_group != null && window_group.has_windows()) {
 			get_style_context().add_class("running");
@@ -641,11 +703,14 @@ public class IconButton : Gtk.ToggleButton {
 			icon.waiting = false;
 		}
 
+		var size = target_icon_size == 0 ? DEFAULT_ICON_SIZE : target_icon_size;
+
 		if (app != null && app.icon != null) {
+			// GTK renders themed icons itself, recoloring symbolic ones and following theme changes
 			icon.set_from_gicon(app.icon, Gtk.IconSize.INVALID);
 		} else if (window_group != null) {
-			var size = target_icon_size == 0 ? DEFAULT_ICON_SIZE : target_icon_size;
-			unowned var pixbuf = window_group.application.get_icon(size, 1);
+			unowned var application = window_group.application;
+			var pixbuf = Budgie.IconCache.get_default().lookup(application, size, 1, () => application.get_icon(size, 1));
 			icon.set_from_pixbuf(pixbuf);
 		} else {
 			icon.set_from_icon_name("image-missing", Gtk.IconSize.INVALID);
@@ -331,7 +331,8 @@ public class TasklistApplet : Budgie.Applet {
 			size = 32;
 		}
 
-		var pixbuf = button.window.get_icon(size, 1);
+		unowned var window = button.window;
+		var pixbuf = Budgie.IconCache.get_default().lookup(window, size, 1, () => window.get_icon(size, 1));
 
 		if (pixbuf == null) return;
 
@@ -31,6 +31,7 @@ public class TasklistButton : ToggleButton {
 	private TasklistButtonPopover popover;
 
 	private Allocation definite_allocation = {};
+	private ulong icon_theme_id = 0;
 
 	public Budgie.PopoverManager popover_manager { get; construct; }
 	public Xfw.Window window { get; construct; }
@@ -79,7 +80,15 @@ public class TasklistButton : ToggleButton {
 		// SIGNALS
 		size_allocate.connect(on_size_allocate);
 		window.name_changed.connect(on_window_name_changed);
-		window.icon_changed.connect(on_window_icon_changed);
+		window.icon_changed.connect(() => {
+			Budgie.IconCache.get_default().invalidate(window);
+			on_window_icon_changed();
+		});
+		icon_theme_id = Budgie.IconCache.get_default().theme_changed.connect(on_window_icon_changed);
+
+		destroy.connect(() => {
+			SignalHandler.disconnect(Budgie.IconCache.get_default(), icon_theme_id);
+		});
 	}
 
 	public void gracefully_die() {
@@ -172,7 +181,8 @@ public class TasklistButton : ToggleButton {
 	private void on_window_icon_changed() {
 		if (definite_allocation.width <= 0 || definite_allocation.height <= 0) return;
 
-		unowned var pixbuf = window.get_icon(compute_icon_size(), 1);
+		var size = compute_icon_size();
+		var pixbuf = Budgie.IconCache.get_default().lookup(window, size, 1, () => window.get_icon(size, 1));
 		icon.set_from_pixbuf(pixbuf);
 	}
 
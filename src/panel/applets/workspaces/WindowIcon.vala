@@ -16,6 +16,8 @@ namespace Workspaces {
 	public class WindowIcon : Gtk.Button {
 		public Xfw.Window window { get; construct; }
 
+		private ulong icon_theme_id = 0;
+
 		construct {
 			this.set_relief(Gtk.ReliefStyle.NONE);
 			this.get_style_context().add_class("workspace-icon-button");
@@ -28,7 +30,7 @@ namespace Workspaces {
 			// there is no application. It will be set when the
 			// icon_changed signal is called.
 			if (this.window.application != null) {
-				unowned var pixbuf = window.get_icon(WORKSPACE_ICON_SIZE, get_scale_factor());
+				var pixbuf = get_window_icon();
 				icon = new Gtk.Image.from_pixbuf(pixbuf);
 			} else {
 				icon = new Gtk.Image.from_icon_name(FALLBACK_ICON_NAME, Gtk.IconSize.INVALID);
@@ -43,10 +45,17 @@ namespace Workspaces {
 			});
 
 			window.icon_changed.connect(() => {
-				unowned var pixbuf = window.get_icon(WORKSPACE_ICON_SIZE, get_scale_factor());
-				icon.set_from_pixbuf(pixbuf);
-				icon.queue_draw();
-				Gtk.drag_source_set_icon_pixbuf(this, pixbuf);
+				Budgie.IconCache.get_default().invalidate(window);
+				update_icon(icon);
+			});
+
+			// Our pixbuf was dropped from the icon cache, so load it from the new theme
+			icon_theme_id = Budgie.IconCache.get_default().theme_changed.connect(() => {
+				if (window.application != null) update_icon(icon);
+			});
+
+			this.destroy.connect(() => {
+				SignalHandler.disconnect(Budgie.IconCache.get_default(), icon_theme_id);
 			});
 
 			Gtk.drag_source_set(
@@ -78,6 +87,20 @@ namespace Workspaces {
 			return Gdk.EVENT_STOP;
 		}
 
+		private void update_icon(Gtk.Image icon) {
+			var pixbuf = get_window_icon();
+			icon.set_from_pixbuf(pixbuf);
+			icon.queue_draw();
+			Gtk.drag_source_set_icon_pixbuf(this, pixbuf);
+		}
+
+		private Gdk.Pixbuf? get_window_icon() {
+			var scale = get_scale_factor();
+			return Budgie.IconCache.get_default().lookup(window, WORKSPACE_ICON_SIZE, scale, () => {
+				return window.get_icon(WORKSPACE_ICON_SIZE, scale);
+			});
+		}
+
 		private void on_drag_begin(Gtk.Widget widget, Gdk.DragContext context) {
 			WorkspacesApplet.dragging = true;
 		}
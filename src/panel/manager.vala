@@ -171,6 +171,7 @@ namespace Budgie {
 		private Budgie.SettingsWindow? settings_window = null;
 
 		Budgie.Windowing.Windowing windowing;
+		uint check_windows_id = 0;
 
 		private string default_layout = "default";
 
@@ -331,27 +332,30 @@ namespace Budgie {
 				if (iface != null) iface.DesktopShown(showing);
 			});
 
-			windowing.window_state_changed.connect((window) => {
-				if (window.is_skip_pager() || window.is_skip_tasklist()) return;
-				check_windows();
+			// Windowing keeps count of the maximized windows, and only tells
+			// us when a monitor gains its first or loses its last one
+			windowing.maximized_state_changed.connect((monitor) => {
+				if (monitor == get_primary_monitor()) {
+					check_windows();
+				}
 			});
 
-			windowing.window_added.connect(window_opened);
-			windowing.window_removed.connect(check_windows);
-			windowing.active_window_changed.connect(check_windows);
-			windowing.active_workspace_changed.connect(check_windows);
+			// Pick up the windows that were already open once the panels exist
+			queue_check_windows();
 		}
 
 		/*
-		* Callback for newly opened, not yet tracked windows
+		* Check the windows once the panels have settled, after they or the
+		* monitors changed and the primary monitor may be a different one
 		*/
-		private void window_opened(Xfw.Window window) {
-			window.state_changed.connect(() => {
-				if (window.is_skip_pager() || window.is_skip_tasklist()) return;
-				check_windows();
-			});
+		private void queue_check_windows() {
+			if (check_windows_id != 0) return;
 
-			check_windows();
+			check_windows_id = Idle.add(() => {
+				check_windows_id = 0;
+				if (raven != null && panels.size() > 0) check_windows();
+				return Source.REMOVE;
+			});
 		}
 
 		private unowned Gdk.Monitor? get_primary_monitor() {
@@ -364,36 +368,12 @@ namespace Budgie {
 
 			var display = ((Gtk.Window) panel).get_display();
 			var gdk_window = ((Gtk.Widget) panel).get_window();
+			// Not realized yet, so it isn't on any monitor
+			if (gdk_window == null) return null;
 
 			return display.get_monitor_at_window(gdk_window);
 		}
 
-		/**
-		* Determine if the window is on the primary screen, i.e. where the main
-		* budgie panels will show
-		* note Xfw window geometry includes scale factors
-		*/
-		bool window_on_primary(Xfw.Window? window) {
-			unowned Gdk.Monitor? primary_monitor = this.get_primary_monitor();
-
-			if (primary_monitor == null) {
-				debug("Primary monitor is NULL");
-				return false;
-			}
-
-			unowned var monitors = window.get_monitors();
-
-			foreach (var monitor in monitors) {
-				unowned var gdk_monitor = monitor.get_gdk_monitor();
-
-				if (gdk_monitor == primary_monitor) {
-					return true;
-				}
-			}
-
-			return false;
-		}
-
 		/*
 		* Decide whether or not the panel should be opaque
 		* The panel should be opaque when:
@@ -407,16 +387,14 @@ namespace Budgie {
 				set_panel_transparent(false, true);
 				return;
 			}
-			bool found_maximized_window = false;
 
-			windowing.windows.foreach((window) => {
-				if (window.is_skip_pager()) return;
-				if (!this.window_on_primary(window)) return;
-				if ((window.is_maximized() && !window.is_minimized())) {
-					found_maximized_window = true;
-					return;
-				}
-			});
+			// Only windows on the primary screen, where the main budgie panels show, count
+			unowned Gdk.Monitor? primary_monitor = this.get_primary_monitor();
+			if (primary_monitor == null) {
+				debug("Primary monitor is NULL");
+			}
+
+			bool found_maximized_window = primary_monitor != null && windowing.has_maximized_window(primary_monitor);
 
 			set_panel_transparent(!found_maximized_window);
 			set_panel_occluded(found_maximized_window);
@@ -608,6 +586,8 @@ namespace Budgie {
 			raven_area.width = primary.area.width;
 			raven_area.height = primary.area.height;
 			this.raven.update_geometry(raven_area);
+
+			queue_check_windows();
 		}
 
 		private void on_bus_acquired(DBusConnection conn) {
@@ -1028,6 +1008,7 @@ namespace Budgie {
 			*/
 			this.update_screen();
 			panel.show();
+			queue_check_windows();
 		}
 
 		/**
@@ -1374,6 +1355,7 @@ namespace Budgie {
 
 			set_panels();
 			show_panel(uuid, position, transparency, policy, dock_mode, shadow_visible, spacing);
+			queue_check_windows();
 
 			if (new_defaults == null || name == null) {
 				this.panel_added(uuid, panels.lookup(uuid));
@@ -1403,6 +1385,8 @@ namespace Budgie {
 				panel.destroy_children();
 				panel.destroy();
 			}
+
+			queue_check_windows();
 		}
 
 		public override void move_panel(string uuid, PanelPosition position) {
@@ -1432,6 +1416,7 @@ namespace Budgie {
 
 			// Load panel again
 			load_panel(uuid, true);
+			queue_check_windows();
 		}
 
 		/**
@@ -13,6 +13,7 @@
 	public class RavenSettingsPage : Budgie.SettingsGrid {
 		private Gtk.ComboBox? raven_position;
 		private Gtk.ComboBox? notification_sort;
+		private Gtk.Switch? persist_notifications;
 		private Settings raven_settings;
 
 		public RavenSettingsPage() {
@@ -72,10 +73,17 @@
 				_("Set whether notifications are sorted from oldest to newest, or newest to oldest.")
 			));
 
-			// Bind the settings to our comboboxes
+			persist_notifications = new Gtk.Switch();
+			add_row(new SettingsRow(persist_notifications,
+				_("Keep notifications across sessions"),
+				_("Store the notifications in Raven on disk so that they are restored after logging in again. Turning this off deletes the stored notifications.")
+			));
+
+			// Bind the settings to our widgets
 			raven_settings = new Settings("com.solus-project.budgie-raven");
 			raven_settings.bind("raven-position", raven_position, "active-id", SettingsBindFlags.DEFAULT);
 			raven_settings.bind("notification-sort", notification_sort, "active-id", SettingsBindFlags.DEFAULT);
+			raven_settings.bind("persist-notifications", persist_notifications, "active", SettingsBindFlags.DEFAULT);
 		}
 	}
 }
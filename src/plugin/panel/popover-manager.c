@@ -110,7 +110,10 @@ void budgie_popover_manager_show_popover(BudgiePopoverManager* self, GtkWidget*
 
 	GtkWidget * toplevel = gtk_widget_get_toplevel(parent_widget);
 
-	g_signal_connect(toplevel, "focus-out-event", G_CALLBACK(on_focus_out), popover);
+	// Connect once per popover, and tie the handler to the popover's lifetime so
+	// that unregistered popovers can be destroyed safely
+	g_signal_handlers_disconnect_by_func(toplevel, G_CALLBACK(on_focus_out), popover);
+	g_signal_connect_object(toplevel, "focus-out-event", G_CALLBACK(on_focus_out), popover, 0);
 
 	BudgiePanelPosition * position = NULL;
 	g_object_get(G_OBJECT(toplevel), "position", &position, NULL);
@@ -0,0 +1,536 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie {
+	/**
+	 * A notification stored in Raven's history.
+	 *
+	 * This only holds the text needed to show the notification again,
+	 * so thousands of them can be kept without building any widgets.
+	 */
+	public class NotificationRecord : Object {
+		/** The D-Bus type of a serialized record. */
+		public const string VARIANT_TYPE = "(ussssssx)";
+
+		/**
+		 * Key of this record in the history. Unlike notification IDs, keys
+		 * are never reused, including across restarts.
+		 */
+		public uint32 key;
+		public string app_name;
+		public string app_id;
+		public string app_icon;
+		public string summary;
+		public string body;
+		public string category;
+		public int64 timestamp;
+
+		/* Link of this record in the history's queue */
+		internal unowned List<unowned NotificationRecord>? link = null;
+
+		/* Link of this record in its Raven group's queue */
+		internal unowned List<unowned NotificationRecord>? group_link = null;
+
+		public NotificationRecord(uint32 key, Budgie.Notification notification) {
+			this.key = key;
+			this.app_name = notification.app_name;
+			this.app_id = notification.app_id ?? "";
+			this.app_icon = notification.notification_icon;
+			this.summary = notification.summary;
+			this.body = notification.body;
+			this.category = notification.category ?? "";
+			this.timestamp = notification.timestamp;
+		}
+
+		public NotificationRecord.from_variant(Variant variant) {
+			variant.get(
+				VARIANT_TYPE,
+				out this.key,
+				out this.app_name,
+				out this.app_id,
+				out this.app_icon,
+				out this.summary,
+				out this.body,
+				out this.category,
+				out this.timestamp
+			);
+		}
+
+		public Variant to_variant() {
+			return new Variant(
+				VARIANT_TYPE,
+				this.key,
+				this.app_name,
+				this.app_id,
+				this.app_icon,
+				this.summary,
+				this.body,
+				this.category,
+				this.timestamp
+			);
+		}
+
+		/**
+		 * Get an image of the application that sent this notification,
+		 * for records that no longer have their notification's images.
+		 */
+		public Gtk.Image create_app_image() {
+			if (this.app_id != "") {
+				var app_info = new DesktopAppInfo("%s.desktop".printf(this.app_id));
+				if (app_info != null && app_info.get_icon() != null) {
+					return new Gtk.Image.from_gicon(app_info.get_icon(), Gtk.IconSize.DND);
+				}
+
+				// Same fallback as Budgie.Notification, the lowercased ID as an icon name
+				var icon_name = this.app_id.down();
+				if (Gtk.IconTheme.get_default().has_icon(icon_name)) {
+					return new Gtk.Image.from_icon_name(icon_name, Gtk.IconSize.DND);
+				}
+			}
+
+			if (this.app_icon != "" && !this.app_icon.contains("/")) {
+				return new Gtk.Image.from_icon_name(this.app_icon, Gtk.IconSize.DND);
+			}
+
+			return new Gtk.Image.from_icon_name("applications-internet", Gtk.IconSize.DND);
+		}
+	}
+
+	/**
+	 * Persistent, bounded history of the notifications stored in Raven.
+	 *
+	 * The history is kept under `$XDG_STATE_HOME/budgie-desktop` as a
+	 * compacted snapshot, plus an append-only log of the changes made
+	 * since the snapshot was written. Each change costs a single short
+	 * asynchronous write, and the log is folded into a new snapshot on a
+	 * worker thread once it has grown larger than the history itself.
+	 *
+	 * When `persistent` is turned off, nothing is written and the files
+	 * on disk are deleted, so the history only lasts for the session.
+	 */
+	public class NotificationHistory : Object {
+		/** Maximum number of notifications to keep. */
+		public const uint MAX_RECORDS = 5000;
+
+		/**
+		 * Version of the snapshot format. Bump this whenever the layout of
+		 * the snapshot or of `NotificationRecord.VARIANT_TYPE` changes.
+		 */
+		private const uint32 VERSION = 1;
+
+		/* Layout: version, next key, and the records from oldest to newest */
+		private const string SNAPSHOT_TYPE = "(uua" + NotificationRecord.VARIANT_TYPE + ")";
+
+		/* Each line of the log is an operation and its argument */
+		private const string LOG_TYPE = "(sv)";
+
+		/** Seconds to wait after the log has grown too large before compacting it. */
+		private const uint COMPACT_DELAY = 30;
+
+		/** Smallest number of log entries that is worth compacting. */
+		private const uint MIN_COMPACT_ENTRIES = 256;
+
+		/** The directory the history is stored in. */
+		public string directory { get; construct; }
+
+		// Records by key, and the same records from oldest to newest
+		private HashTable<uint32, NotificationRecord> records_by_key;
+		private Queue<unowned NotificationRecord> records;
+		private uint32 next_key = 1;
+
+		private FileOutputStream? log_stream = null;
+		private StringBuilder log_buffer = new StringBuilder();
+		private bool writing_log = false;
+		private uint log_entries = 0;
+		private uint compact_id = 0;
+		private bool compacting = false;
+		private bool _persistent = true;
+
+		/**
+		 * Emitted when the oldest record is dropped to stay within
+		 * `MAX_RECORDS`.
+		 */
+		public signal void record_trimmed(NotificationRecord record);
+
+		/** The number of notifications in the history. */
+		public uint length {
+			get { return this.records.length; }
+		}
+
+		/**
+		 * Whether the history is kept on disk. Turning this off deletes
+		 * what is stored, and turning it back on stores the current history.
+		 */
+		public bool persistent {
+			get { return this._persistent; }
+			set {
+				if (value == this._persistent) return;
+				this._persistent = value;
+
+				if (value) {
+					this.compact();
+				} else {
+					this.delete_files();
+				}
+			}
+		}
+
+		public NotificationHistory() {
+			Object(directory: Path.build_filename(get_state_dir(), "budgie-desktop"));
+		}
+
+		construct {
+			this.records_by_key = new HashTable<uint32, NotificationRecord>(direct_hash, direct_equal);
+			this.records = new Queue<unowned NotificationRecord>();
+		}
+
+		private static string get_state_dir() {
+			var dir = Environment.get_variable("XDG_STATE_HOME");
+			if (dir == null || !Path.is_absolute(dir)) {
+				dir = Path.build_filename(Environment.get_home_dir(), ".local", "state");
+			}
+
+			return dir;
+		}
+
+		private string get_snapshot_path() {
+			return Path.build_filename(this.directory, "notifications");
+		}
+
+		private string get_log_path() {
+			return Path.build_filename(this.directory, "notifications.log");
+		}
+
+		private string get_old_log_path() {
+			return Path.build_filename(this.directory, "notifications.log.old");
+		}
+
+		/**
+		 * Get the records in the history, from oldest to newest.
+		 *
+		 * The list belongs to the history and must not be modified.
+		 */
+		public unowned List<unowned NotificationRecord>? peek_records() {
+			return this.records.head;
+		}
+
+		/**
+		 * Load the history from disk, replacing anything in memory.
+		 */
+		public void load() {
+			this.remove_all();
+			this.next_key = 1;
+
+			if (!this.persistent) return;
+
+			try {
+				var mapped = new MappedFile(this.get_snapshot_path(), false);
+				var data = new Variant.from_bytes(new VariantType(SNAPSHOT_TYPE), mapped.get_bytes(), false);
+
+				if (data.get_child_value(0).get_uint32() == VERSION) {
+					this.next_key = data.get_child_value(1).get_uint32();
+
+					var cached_records = data.get_child_value(2);
+					for (size_t i = 0; i < cached_records.n_children(); i++) {
+						this.insert(new NotificationRecord.from_variant(cached_records.get_child_value(i)));
+					}
+				} else {
+					debug("Ignoring notification history from a different version");
+				}
+			} catch (FileError e) {
+				if (!(e is FileError.NOENT)) {
+					warning("Unable to read notification history: %s", e.message);
+				}
+			}
+
+			// Replay the changes made since the snapshot was written, starting
+			// with a log that was set aside for a compaction that didn't finish
+			this.replay_log(this.get_old_log_path());
+			this.replay_log(this.get_log_path());
+			this.trim();
+
+			// Start the next session with a fresh log
+			this.compact();
+		}
+
+		private void replay_log(string path) {
+			string contents;
+			try {
+				FileUtils.get_contents(path, out contents);
+			} catch (FileError e) {
+				if (!(e is FileError.NOENT)) {
+					warning("Unable to read notification history log: %s", e.message);
+				}
+				return;
+			}
+
+			var log_type = new VariantType(LOG_TYPE);
+			foreach (unowned var line in contents.split("\n")) {
+				if (line == "") continue;
+
+				try {
+					this.replay(Variant.parse(log_type, line));
+				} catch (VariantParseError e) {
+					// Most likely the last line, if we were stopped while writing it
+					debug("Skipping invalid notification history entry: %s", e.message);
+				}
+			}
+		}
+
+		/*
+		 * Apply a change from the log. The log may overlap with the snapshot
+		 * if we were stopped while compacting, so replaying a change that is
+		 * already in the snapshot must leave it as it is.
+		 */
+		private void replay(Variant entry) {
+			var op = entry.get_child_value(0).get_string();
+			var arg = entry.get_child_value(1).get_variant();
+
+			switch (op) {
+				case "add":
+					if (!arg.is_of_type(new VariantType(NotificationRecord.VARIANT_TYPE))) return;
+
+					var record = new NotificationRecord.from_variant(arg);
+					if (this.records_by_key.contains(record.key)) return;
+
+					this.insert(record);
+					this.next_key = uint32.max(this.next_key, record.key + 1);
+					break;
+				case "remove":
+					if (!arg.is_of_type(VariantType.UINT32)) return;
+					this.unlink(arg.get_uint32());
+					break;
+				case "clear":
+					this.remove_all();
+					break;
+			}
+		}
+
+		/**
+		 * Add a notification to the history.
+		 *
+		 * Returns: the record of the notification
+		 */
+		public NotificationRecord add(Budgie.Notification notification) {
+			var record = new NotificationRecord(this.next_key++, notification);
+
+			this.insert(record);
+			this.trim();
+			this.append_log("add", record.to_variant());
+
+			return record;
+		}
+
+		/**
+		 * Remove a notification from the history.
+		 */
+		public void remove(uint32 key) {
+			if (!this.unlink(key)) return;
+
+			this.append_log("remove", new Variant.uint32(key));
+		}
+
+		/**
+		 * Remove every notification from the history.
+		 */
+		public void clear() {
+			this.remove_all();
+
+			this.append_log("clear", new Variant.boolean(true));
+		}
+
+		private void insert(NotificationRecord record) {
+			this.records_by_key.insert(record.key, record);
+			this.records.push_tail(record);
+			record.link = this.records.peek_tail_link();
+		}
+
+		/* Drop the oldest records until the history fits in MAX_RECORDS */
+		private void trim() {
+			while (this.records.length > MAX_RECORDS) {
+				NotificationRecord oldest = this.records.pop_head();
+				oldest.link = null;
+				this.records_by_key.remove(oldest.key);
+				this.record_trimmed(oldest);
+			}
+		}
+
+		private bool unlink(uint32 key) {
+			unowned var record = this.records_by_key.lookup(key);
+			if (record == null) return false;
+
+			this.records.delete_link(record.link);
+			this.records_by_key.remove(key);
+			return true;
+		}
+
+		private void remove_all() {
+			this.records.clear();
+			this.records_by_key.remove_all();
+		}
+
+		private void append_log(string op, Variant arg) {
+			if (!this.persistent) return;
+
+			this.log_buffer.append(new Variant.tuple({ new Variant.string(op), new Variant.variant(arg) }).print(false));
+			this.log_buffer.append_c('\n');
+			this.write_log.begin();
+
+			this.log_entries++;
+
+			if (this.compact_id == 0 && this.log_entries > uint.max(MIN_COMPACT_ENTRIES, this.records.length)) {
+				this.compact_id = Timeout.add_seconds(COMPACT_DELAY, () => {
+					this.compact_id = 0;
+					this.compact();
+					return Source.REMOVE;
+				});
+			}
+		}
+
+		/**
+		 * Write the buffered log entries without blocking the main loop.
+		 *
+		 * Only one write runs at a time, and entries added while it runs
+		 * are written by the same call once it is done.
+		 */
+		private async void write_log() {
+			if (this.writing_log) return;
+			this.writing_log = true;
+
+			while (this.log_buffer.len > 0 && this.persistent) {
+				var data = this.log_buffer.str;
+				this.log_buffer.truncate();
+
+				try {
+					if (this.log_stream == null) {
+						DirUtils.create_with_parents(this.directory, 0700);
+						this.log_stream = yield File.new_for_path(this.get_log_path()).append_to_async(FileCreateFlags.PRIVATE, Priority.DEFAULT, null);
+					}
+
+					yield this.log_stream.write_all_async(data.data, Priority.DEFAULT, null, null);
+				} catch (Error e) {
+					warning("Unable to write notification history: %s", e.message);
+					this.log_stream = null;
+				}
+			}
+
+			this.writing_log = false;
+		}
+
+		/**
+		 * Write the history to a new snapshot on a worker thread, and
+		 * start a new log.
+		 *
+		 * The log is set aside first, so that changes made while the
+		 * snapshot is written go to the new log. The old one is only
+		 * deleted once the snapshot holds everything in it.
+		 */
+		private void compact() {
+			this.cancel_compact();
+			if (!this.persistent || this.compacting) return;
+
+			// Only set the log aside if the last one was folded into a snapshot,
+			// otherwise keep adding to the current one so nothing is lost
+			if (!FileUtils.test(this.get_old_log_path(), FileTest.EXISTS)) {
+				if (!FileUtils.test(this.get_log_path(), FileTest.EXISTS) || FileUtils.rename(this.get_log_path(), this.get_old_log_path()) == 0) {
+					this.close_log();
+				}
+			}
+
+			// Records never change once created, so the thread can serialize them
+			NotificationRecord[] snapshot_records = {};
+			foreach (unowned var record in this.records.head) {
+				snapshot_records += record;
+			}
+
+			this.compacting = true;
+			this.write_snapshot.begin((owned) snapshot_records, this.next_key, (obj, res) => {
+				this.compacting = false;
+
+				// Turned off while writing, so don't leave anything behind
+				if (!this.persistent) this.delete_files();
+			});
+		}
+
+		private async void write_snapshot(owned NotificationRecord[] snapshot_records, uint32 snapshot_next_key) {
+			SourceFunc callback = write_snapshot.callback;
+			var directory = this.directory;
+			var snapshot_path = this.get_snapshot_path();
+			var old_log_path = this.get_old_log_path();
+
+			ThreadFunc<void> func = () => {
+				var builder = new VariantBuilder(new VariantType("a" + NotificationRecord.VARIANT_TYPE));
+				foreach (unowned var record in snapshot_records) {
+					builder.add_value(record.to_variant());
+				}
+
+				var data = new Variant.tuple({
+					new Variant.uint32(VERSION),
+					new Variant.uint32(snapshot_next_key),
+					builder.end(),
+				});
+
+				try {
+					DirUtils.create_with_parents(directory, 0700);
+					// set_data writes to a temporary file first, so the snapshot is never partial
+					FileUtils.set_data(snapshot_path, data.get_data_as_bytes().get_data());
+					FileUtils.unlink(old_log_path);
+				} catch (FileError e) {
+					warning("Unable to write notification history: %s", e.message);
+				}
+
+			};
+
+			try {
+				new Thread<void>.try("budgie-notification-history", () => {
+					func();
+					Idle.add((owned) callback);
+				});
+			} catch (Error e) {
+				warning("Unable to start notification history thread: %s", e.message);
+				func();
+				Idle.add((owned) callback);
+			}
+
+			yield;
+		}
+
+		/**
+		 * Delete the history from disk, keeping it in memory.
+		 */
+		private void delete_files() {
+			this.cancel_compact();
+			this.close_log();
+			this.log_buffer.truncate();
+
+			FileUtils.unlink(this.get_log_path());
+			FileUtils.unlink(this.get_old_log_path());
+			FileUtils.unlink(this.get_snapshot_path());
+		}
+
+		private void cancel_compact() {
+			if (this.compact_id != 0) {
+				Source.remove(this.compact_id);
+				this.compact_id = 0;
+			}
+		}
+
+		/*
+		 * Stop writing to the current log. A write that is still running
+		 * holds its own reference to the stream, which is closed once that
+		 * reference is dropped.
+		 */
+		private void close_log() {
+			this.log_stream = null;
+			this.log_entries = 0;
+		}
+	}
+}
@@ -10,12 +10,12 @@
  */
 
 public class NotificationWidget : Gtk.ListBoxRow {
-	public Budgie.Notification notification { get; construct; }
+	public Budgie.NotificationRecord record { get; construct; }
 
 	public signal void closed_individually();
 
-	public NotificationWidget(Budgie.Notification notification) {
-		Object(notification: notification);
+	public NotificationWidget(Budgie.NotificationRecord record) {
+		Object(record: record);
 	}
 
 	construct {
@@ -31,7 +31,7 @@ public class NotificationWidget : Gtk.ListBoxRow {
 		dismiss_button.get_style_context().add_class("flat");
 		dismiss_button.get_style_context().add_class("image-button");
 
-		var label_title = new Gtk.Label(notification.summary) {
+		var label_title = new Gtk.Label(record.summary) {
 			ellipsize = Pango.EllipsizeMode.END,
 			halign = Gtk.Align.START,
 			justify = Gtk.Justification.LEFT,
@@ -39,8 +39,8 @@ public class NotificationWidget : Gtk.ListBoxRow {
 		};
 
 		Gtk.Label label_body = null;
-		if (notification.body != "") { // If there is body content
-			label_body = new Gtk.Label(notification.body) {
+		if (record.body != "") { // If there is body content
+			label_body = new Gtk.Label(record.body) {
 				halign = Gtk.Align.START,
 				justify = Gtk.Justification.LEFT,
 				use_markup = true,
@@ -51,7 +51,7 @@ public class NotificationWidget : Gtk.ListBoxRow {
 			};
 		}
 
-		var date = new DateTime.from_unix_local(notification.timestamp);
+		var date = new DateTime.from_unix_local(record.timestamp);
 
 		var gnome_settings = new Settings("org.gnome.desktop.interface");
 		string clock_format = gnome_settings.get_string("clock-format");
@@ -12,20 +12,31 @@
 namespace Budgie {
 	/**
 	 * NotificationGroup is a group of notifications.
+	 *
+	 * The group holds the records of its notifications, and only creates
+	 * widgets for them while it is expanded and shown in Raven.
 	 */
 	public class NotificationGroup : Gtk.ListBoxRow {
-		private HashTable<uint32, NotificationWidget> notifications;
+		// Records by key, and the same records from oldest to newest
+		private HashTable<uint32, NotificationRecord> notifications;
+		private Queue<unowned NotificationRecord> order;
+		private HashTable<uint32, NotificationWidget> widgets;
+		private bool view_visible = false;
 
 		private Gtk.Label name_label;
+		private Gtk.Button expand_button;
 		private Gtk.Button dismiss_button;
 		private Gtk.ListBox noti_box;
 
 		public string app_name { get; construct; }
 		public Gtk.Image image { get; construct; }
-		public uint tokeep { get; construct set; }
+		public uint tokeep { get; construct; }
 		public NotificationSort noti_sort_mode { get; construct set; default = NEW_OLD; }
 		public int noti_count { get; private set; default = 0; }
 
+		/** Whether the notifications of this group are shown, or only its header. */
+		public bool expanded { get; set; default = true; }
+
 		/* Signals */
 
 		public signal void dismissed_group(string app_name);
@@ -34,12 +45,15 @@ namespace Budgie {
 		construct {
 			get_style_context().add_class("raven-notifications-group");
 
-			notifications = new HashTable<uint32, NotificationWidget>(direct_hash, direct_equal);
+			notifications = new HashTable<uint32, NotificationRecord>(direct_hash, direct_equal);
+			order = new Queue<unowned NotificationRecord>();
+			widgets = new HashTable<uint32, NotificationWidget>(direct_hash, direct_equal);
 
 			noti_box = new Gtk.ListBox() {
 				can_focus = false,
 				focus_on_click = false,
 				selection_mode = Gtk.SelectionMode.NONE,
+				no_show_all = true,
 			};
 			noti_box.set_sort_func(sort_notifications);
 
@@ -70,9 +84,21 @@ namespace Budgie {
 
 			dismiss_button.clicked.connect(dismiss_all);
 
+			expand_button = new Gtk.Button() {
+				valign = Gtk.Align.CENTER,
+				halign = Gtk.Align.END,
+			};
+			expand_button.get_style_context().add_class("flat");
+			expand_button.get_style_context().add_class("image-button");
+
+			expand_button.clicked.connect(() => {
+				expanded = !expanded;
+			});
+
 			header.pack_start(app_icon, false, false, 0);
 			header.pack_start(name_label, false, false, 0);
 			header.pack_end(dismiss_button, false, false, 0);
+			header.pack_end(expand_button, false, false, 0);
 
 			var box = new Gtk.Box(Gtk.Orientation.VERTICAL, 4) {
 				margin = 4,
@@ -82,14 +108,18 @@ namespace Budgie {
 			box.pack_start(noti_box);
 
 			add(box);
+
+			notify["expanded"].connect(update_widgets);
+			update_widgets();
 		}
 
-		public NotificationGroup(Budgie.Notification notification, NotificationSort sort_mode, uint keep) {
+		public NotificationGroup(NotificationRecord record, Gtk.Image image, NotificationSort sort_mode, uint keep, bool expanded) {
 			Object(
-				app_name: notification.app_name,
-				image: notification.app_image ?? notification.image ?? new Gtk.Image.from_icon_name("applications-internet", Gtk.IconSize.DND),
+				app_name: record.app_name,
+				image: image,
 				tokeep: keep,
 				noti_sort_mode: sort_mode,
+				expanded: expanded,
 				activatable: false,
 				selectable: false,
 				can_focus: false,
@@ -100,33 +130,95 @@ namespace Budgie {
 		/**
 		 * add_notification is responsible for adding a notification (if it doesn't exist) and updating our counter
 		 */
-		public void add_notification(uint32 id, Budgie.Notification notification) {
-			if (notifications.contains(id)) { // If this id already exists
-				remove_notification(id); // Remove the current one first
+		public void add_notification(NotificationRecord record) {
+			if (notifications.contains(record.key)) { // If this key already exists
+				remove_notification(record.key); // Remove the current one first
 			}
 
-			var widget = new NotificationWidget(notification);
-			notifications.insert(id, widget);
-			noti_box.prepend(widget);
+			// Keys only ever grow, so the newest notification always goes last
+			notifications.insert(record.key, record);
+			order.push_tail(record);
+			record.group_link = order.peek_tail_link();
+
+			// Rows are inserted in sorted position, so there's no need to re-sort
+			if (widgets_shown()) add_widget(record);
 
-			noti_box.invalidate_sort();
 			update_count();
+			limit_notifications();
+		}
 
+		/**
+		 * Set whether the view this group is in is visible, so that the
+		 * widgets for its notifications are only kept around while they
+		 * can be seen.
+		 */
+		public void set_view_visible(bool visible) {
+			if (view_visible == visible) return;
+
+			view_visible = visible;
+			update_widgets();
+		}
+
+		private bool widgets_shown() {
+			return expanded && view_visible;
+		}
+
+		private void add_widget(NotificationRecord record) {
+			var widget = new NotificationWidget(record);
+			widgets.insert(record.key, widget);
+			noti_box.prepend(widget);
+			widget.show_all();
+
+			var key = record.key;
 			widget.closed_individually.connect(() => { // When this notification is closed
-				remove_notification((uint) notification.id);
+				remove_notification(key);
 			});
 		}
 
+		/**
+		 * Create or destroy the widgets of our notifications to match
+		 * whether they can be seen.
+		 */
+		private void update_widgets() {
+			var arrow = expanded ? "pan-down-symbolic" : "pan-end-symbolic";
+			expand_button.set_image(new Gtk.Image.from_icon_name(arrow, Gtk.IconSize.MENU));
+			expand_button.tooltip_text = expanded ? _("Collapse") : _("Expand");
+
+			if (!widgets_shown()) {
+				noti_box.hide();
+				widgets.foreach_remove((key, widget) => {
+					widget.destroy();
+					return true;
+				});
+				return;
+			}
+
+			if (widgets.length == 0) {
+				foreach (unowned var record in order.head) {
+					add_widget(record);
+				}
+			}
+
+			noti_box.show();
+		}
+
 		/**
 		 * dismiss_all is responsible for dismissing all notifications
 		 */
 		public void dismiss_all() {
-			notifications.foreach_remove((id, widget) => {
+			widgets.foreach_remove((key, widget) => {
 				widget.destroy();
-				dismissed_notification(id);
 				return true;
 			});
 
+			foreach (unowned var record in order.head) {
+				record.group_link = null;
+				dismissed_notification(record.key);
+			}
+
+			order.clear();
+			notifications.remove_all();
+
 			update_count();
 			dismissed_group(app_name);
 		}
@@ -135,14 +227,18 @@ namespace Budgie {
 		 * remove_notification is responsible for removing a notification (if it exists) and updating our counter
 		 */
 		public void remove_notification(uint32 id) {
-			var widget = notifications.lookup(id); // Get our notification
+			unowned var record = notifications.lookup(id);
 
-			if (widget != null) { // If this notification exists
+			if (record != null) { // If this notification exists
+				order.delete_link(record.group_link);
+				record.group_link = null;
 				notifications.remove(id);
 
-				widget.destroy();
+				NotificationWidget? widget;
+				if (widgets.steal_extended(id, null, out widget)) {
+					widget.destroy();
+				}
 
-				noti_box.invalidate_sort();
 				update_count(); // Update our counter
 				dismissed_notification(id); // Notify anything listening
 
@@ -156,51 +252,18 @@ namespace Budgie {
 		 * too many notifications will choke raven and the desktop, so let's set a limit;
 		 * keep the latest n-notifications of current group, delete older ones
 		 */
-		public void limit_notifications() {
-			GLib.List<uint32> currnotifs = notifications.get_keys();
-
-			currnotifs.sort((a, b) => {
-				return (int) (a > b) - (int) (a < b);
-			});
-
-			uint n_currnotifs = currnotifs.length();
-
-			/**
-			 * no need to reduce if the current number of notifications is below our threshold
-			 * and we shouldn't attempt to set a negative uint
-			 */
-			if (n_currnotifs <= tokeep) return;
-			uint n_remove = n_currnotifs - tokeep;
-			int count = 0;
-
-			foreach (uint n in currnotifs) {
-				if (count >= n_remove) {
-					break;
-				}
-
-				remove_notification(n);
-				count++;
+		private void limit_notifications() {
+			while (order.length > tokeep) {
+				remove_notification(order.peek_head().key);
 			}
 		}
 
-		/**
-		 * if the total number of notifications exceeds threshold, NotificationsView will
-		 * update the max number per group ('tokeep')
-		 */
-		public void set_group_max_notifications(uint keep) {
-			tokeep = keep;
-		}
-
 		/**
 		 * update_count updates our notifications count for this group
 		 */
 		private void update_count() {
 			noti_count = (int) notifications.length;
 
-			if (noti_count > tokeep) {
-				limit_notifications();
-			}
-
 			name_label.set_markup("<b>%s (%i)</b>".printf(app_name, noti_count));
 		}
 
@@ -210,9 +273,9 @@ namespace Budgie {
 
 			switch (noti_sort_mode) {
 				case NEW_OLD:
-					return (int) (noti_b.notification.timestamp - noti_a.notification.timestamp);
+					return (int) (noti_b.record.timestamp - noti_a.record.timestamp);
 				case OLD_NEW:
-					return (int) (noti_a.notification.timestamp - noti_b.notification.timestamp);
+					return (int) (noti_a.record.timestamp - noti_b.record.timestamp);
 			}
 
 			return 0;
@@ -71,11 +71,8 @@ namespace Budgie {
 	public class NotificationsView : Gtk.Box {
 		private const string BUDGIE_PANEL_SCHEMA = "com.solus-project.budgie-panel";
 		private const string BUDGIE_RAVEN_SCHEMA = "com.solus-project.budgie-raven";
-		private const string APPLICATION_SCHEMA = "org.gnome.desktop.notifications.application";
-		private const string APPLICATION_PREFIX = "/org/gnome/desktop/notifications/application";
-		private const uint TOTAL_MAX_NOTIFICATIONS = 500;
-		private const uint DEFAULT_MAX_PERGROUP = 25;
-		private uint max_per_group = DEFAULT_MAX_PERGROUP;
+		/* The history caps the total number of notifications, this caps each application */
+		private const uint MAX_PER_GROUP = 250;
 
 		private HeaderWidget? header = null;
 		private Gtk.Button button_mute;
@@ -89,7 +86,11 @@ namespace Budgie {
 
 		private Dispatcher dispatcher;
 		private HashTable<uint32, Budgie.Notification> notifications;
-		private int notification_count;
+		private NotificationHistory history;
+		private HashTable<string, unowned NotificationGroup> groups;
+
+		/* Keys of the notifications that arrived this session and haven't been dismissed */
+		private GenericSet<uint32> unread;
 
 		private Settings budgie_settings;
 		private Settings raven_settings;
@@ -129,7 +130,8 @@ namespace Budgie {
 			pack_start(header, false, false, 0);
 
 			notifications = new HashTable<uint32, Budgie.Notification>(direct_hash, direct_equal);
-			notification_count = 0;
+			groups = new HashTable<string, unowned NotificationGroup>(str_hash, str_equal);
+			unread = new GenericSet<uint32>(direct_hash, direct_equal);
 
 			var scrolledwindow = new Gtk.ScrolledWindow(null, null);
 			scrolledwindow.get_style_context().add_class("raven-background");
@@ -146,13 +148,29 @@ namespace Budgie {
 			raven_settings.changed["notification-sort"].connect((key) => {
 				sort_mode = (NotificationSort) raven_settings.get_enum(key);
 				listbox.foreach((row) => {
-					var group = ((Gtk.ListBoxRow) row).get_child() as NotificationGroup;
-					group.set_sort_mode(sort_mode);
+					((NotificationGroup) row).set_sort_mode(sort_mode);
 				});
 			});
 			sort_mode = (NotificationSort) raven_settings.get_enum("notification-sort");
 
+			// Only keep notification widgets around while they can be seen
+			map.connect(() => set_groups_visible(true));
+			unmap.connect(() => set_groups_visible(false));
+
 			show_all();
+
+			// Restore the notifications from previous sessions, collapsed so that
+			// no widgets are created for them until they are asked for. They were
+			// already seen, so they don't count as unread.
+			history = new NotificationHistory();
+			history.record_trimmed.connect(on_record_trimmed);
+			raven_settings.bind("persist-notifications", history, "persistent", SettingsBindFlags.GET);
+			history.load();
+
+			foreach (unowned var record in history.peek_records()) {
+				add_record(record, false);
+			}
+
 			update_child_count();
 
 			Bus.get_proxy.begin<Dispatcher>(
@@ -219,25 +237,13 @@ namespace Budgie {
 
 			this.notifications[id] = notification;
 
-			string settings_app_name = notification.app_name;
-
-			// If this notification has a desktop entry in the hints,
-			// set the app name to get the settings for to it.
-			if ("desktop-entry" in hints) {
-				settings_app_name = hints.lookup("desktop-entry").get_string().replace(".", "-").down(); // This is necessary because Notifications application-children change . to - as well
-			}
-
-			Settings application_settings = new Settings.full(
-				SettingsSchemaSource.get_default().lookup(APPLICATION_SCHEMA, true),
-				null,
-				"%s/%s/".printf(APPLICATION_PREFIX, settings_app_name)
-			);
+			var application_settings = NotificationSettingsCache.get_default().lookup(notification.app_name, hints);
 
 			// If popups aren't being shown, immediately call our close function to put
 			// the notification in Raven.
 			bool no_popup = this.do_not_disturb ||
 							this.dispatcher.notifications_paused ||
-							!application_settings.get_boolean("show-banners");
+							(application_settings != null && !application_settings.show_banners);
 
 			if (no_popup) {
 				on_notification_closed(id, notification.app_name, NotificationCloseReason.EXPIRED);
@@ -261,100 +267,91 @@ namespace Budgie {
 
 			if (!should_store) return;
 
+			// Transient notifications must not be kept once they are gone
+			unowned Variant? transient_hint = notification.hints.lookup("transient");
+			if (transient_hint != null && transient_hint.is_of_type(VariantType.BOOLEAN) && transient_hint.get_boolean()) return;
+
+			var record = history.add(notification);
+			unread.add(record.key);
+			add_record(record, true, notification.app_image ?? notification.image);
+			update_child_count();
+			Raven.get_instance().UnreadNotifications();
+		}
+
+		/**
+		 * Add a stored notification to its group, creating the group if
+		 * this is the first notification from its application.
+		 *
+		 * A new group shows `image`, which live notifications take from
+		 * their application or image hints. Groups for restored records
+		 * look the image up from the record instead.
+		 */
+		private void add_record(NotificationRecord record, bool expanded, Gtk.Image? image = null) {
 			// Look for an existing group. If one doesn't exist, create it
-			var group = get_notification_group(notification.app_name) ?? get_notification_group(notification.app_id);
+			var group = get_notification_group(record.app_name) ?? get_notification_group(record.app_id);
 			if (group == null) {
-				group = new NotificationGroup(notification, sort_mode, max_per_group);
+				group = new NotificationGroup(record, image ?? record.create_app_image(), sort_mode, MAX_PER_GROUP, expanded);
+				group.set_view_visible(get_mapped());
 				listbox.add(group);
+				groups.insert(group.app_name, group);
 
 				group.dismissed_group.connect((name) => { // When we dismiss the group
-					notification_count -= group.noti_count;
+					groups.remove(name);
 					update_child_count();
 					Raven.get_instance().ReadNotifications(); // Update our counter
 					group.destroy();
 				});
 
-				group.dismissed_notification.connect((id) => {
-					notification_count--;
+				group.dismissed_notification.connect((key) => {
+					history.remove(key);
+					unread.remove(key);
 					update_child_count();
 					Raven.get_instance().ReadNotifications(); // Update our counter
 				});
 			}
 
-			// Add the notification to the group, and notify Raven
-			group.add_notification(id, notification);
+			group.add_notification(record);
 			group.show_all();
-			notification_count++;
-			update_child_count();
-			Raven.get_instance().UnreadNotifications();
 		}
 
-		private NotificationGroup? get_notification_group(string? name) {
-			if (name == null) return null;
-
-			foreach (var group in listbox.get_children()) {
-				if (((NotificationGroup) group).app_name == name) {
-					return group as NotificationGroup;
-				}
-			}
-
-			return null;
+		private void on_record_trimmed(NotificationRecord record) {
+			var group = get_notification_group(record.app_name) ?? get_notification_group(record.app_id);
+			if (group != null) group.remove_notification(record.key);
 		}
 
-		void adjust_max_per_group(uint newmax, bool trim) {
-			foreach (var group in listbox.get_children()) {
-				((NotificationGroup) group).set_group_max_notifications(max_per_group);
-				if (trim) {
-					((NotificationGroup) group).limit_notifications();
-				}
-			}
+		private void set_groups_visible(bool visible) {
+			groups.foreach((name, group) => group.set_view_visible(visible));
 		}
 
-		void check_notification_allocation(uint len) {
-			uint n_groups = listbox.get_children().length();
-			uint newmax = max_per_group;
-			bool trim = false;
-			if (n_groups == 0) {
-				/* if no notifications left, set to DEFAULT_MAX_PERGROUP */
-				newmax = DEFAULT_MAX_PERGROUP;
-			} else if (len > TOTAL_MAX_NOTIFICATIONS) {
-				/* if totalmax is exceeded, reduce max per group */
-				newmax = (uint)((float)TOTAL_MAX_NOTIFICATIONS/(float)n_groups);
-				trim = true;
-			} else if (
-				max_per_group < DEFAULT_MAX_PERGROUP &&
-				(n_groups * (max_per_group + 1)) <= TOTAL_MAX_NOTIFICATIONS
-			) {
-				/* if we previously reduced group size but now can add at least one back */
-				newmax = (uint)((float)TOTAL_MAX_NOTIFICATIONS/(float)n_groups);
-			}
-			if (newmax != max_per_group) {
-				max_per_group = newmax;
-				adjust_max_per_group(newmax, trim);
-			}
+		private NotificationGroup? get_notification_group(string? name) {
+			if (name == null || name == "") return null;
+
+			return groups.lookup(name);
 		}
 
 		void update_child_count() {
 			string? text = null;
+			uint unread_count = unread.length;
 
-			if (notification_count > 0) {
-				text = (ngettext("%u unread notification", "%u unread notifications", notification_count)).printf(notification_count);
+			if (unread_count > 0) {
+				text = (ngettext("%u unread notification", "%u unread notifications", unread_count)).printf(unread_count);
 			} else {
 				text = _("No unread notifications");
 			}
 
-			Raven.get_instance().set_notification_count(notification_count);
+			Raven.get_instance().set_notification_count(unread_count);
 			header.text = text;
-			clear_notifications_button.set_visible((notification_count > 0)); // Only show clear notifications button if we actually have notifications
-			check_notification_allocation(notification_count);
+			clear_notifications_button.set_visible((history.length > 0)); // Only show clear notifications button if we actually have notifications
 		}
 
 		void clear_all() {
 			foreach (var child in listbox.get_children()) {
 				child.destroy();
 			}
+			groups.remove_all();
 
-			notification_count = 0;
+			history.clear();
+			unread.remove_all();
 			update_child_count();
 			Raven.get_instance().ReadNotifications();
 		}
@@ -0,0 +1,352 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie.Windowing {
+	/**
+	 * Handles matching windows to desktop application files.
+	 *
+	 * This class implements the window-to-desktop-ID matching methods
+	 * inspired by GNOME Shell, KDE Plasma, and BAMF. It handles:
+	 * - StartupWMClass matching (primary method)
+	 * - Reverse-DNS naming (com.example.App)
+	 * - Java package naming (org-gjt-sp-jedit-jEdit)
+	 * - Snap naming patterns (snap-name_app-name)
+	 * - Case-insensitive fallbacks
+	 *
+	 * There is a single matcher shared by everything in the process, see
+	 * `get_default()`.
+	 */
+	public class ApplicationMatcher : GLib.Object {
+		private static ApplicationMatcher? instance = null;
+
+		/**
+		 * Result of a matching operation.
+		 */
+		public class MatchResult {
+			public string? desktop_id { get; set; }
+
+			public bool matched() {
+				return desktop_id != null;
+			}
+		}
+
+		/* Desktop IDs of the installed applications, in the order of `AppInfo.get_all()` */
+		private string[] indexed_ids;
+
+		/*
+		 * Indexes of the lowercased names each matching strategy compares
+		 * against, mapped to the first application in `indexed_ids` that
+		 * has that name.
+		 */
+		private HashTable<string, uint> wm_class_index;
+		private HashTable<string, uint> desktop_id_index;
+		private HashTable<string, uint> reverse_dns_index;
+		private HashTable<string, uint> snap_index;
+
+		/* Executable basenames, which are compared case-sensitively */
+		private HashTable<string, uint> exec_index;
+
+		/* Map of WM_CLASS instance and class pairs to the desktop ID they matched, or "" */
+		private HashTable<string, string> match_cache;
+
+		private AppInfoMonitor app_monitor;
+		private bool index_valid = false;
+
+		private ApplicationMatcher() {
+			Object();
+		}
+
+		construct {
+			app_monitor = AppInfoMonitor.@get();
+			app_monitor.changed.connect(() => {
+				index_valid = false;
+			});
+		}
+
+		/**
+		 * Get the application matcher shared by everything in this process.
+		 *
+		 * Returns: the shared ApplicationMatcher
+		 */
+		public static unowned ApplicationMatcher get_default() {
+			if (instance == null) {
+				instance = new ApplicationMatcher();
+			}
+
+			return instance;
+		}
+
+		/**
+		 * Find the desktop file for a newly opened application.
+		 *
+		 * The application's class ID is tried as a desktop ID first, and
+		 * the window is matched against the installed applications if there
+		 * is no such desktop file.
+		 *
+		 * Returns: the DesktopAppInfo of the application, or null
+		 */
+		public DesktopAppInfo? match_application(Xfw.Application application, Xfw.Window window) {
+			var app_info = new DesktopAppInfo(application.get_class_id() + ".desktop");
+			if (app_info != null) {
+				return app_info;
+			}
+
+			var match_result = match_window(window);
+			if (!match_result.matched()) {
+				return null;
+			}
+
+			return new DesktopAppInfo(match_result.desktop_id);
+		}
+
+		/**
+		 * Find the desktop ID that matches a window.
+		 *
+		 * The first installed application that matches any of the strategies
+		 * wins. Applications are looked up in an index of the names that each
+		 * strategy compares against, and the results are cached per WM_CLASS
+		 * until the installed applications change.
+		 *
+		 * @param window The window to match
+		 * @return MatchResult containing the desktop ID, if found. If not found, the desktop ID will be null
+		 */
+		public MatchResult match_window(Xfw.Window window) {
+			var match_result = new MatchResult();
+			var class_ids = window.get_class_ids();
+			if (class_ids == null || class_ids.length == 0) {
+				debug(@"Got no class_ids for window='$(window.get_name())");
+				return match_result;
+			}
+
+			string instance = class_ids[0];
+			string? class_name = null;
+
+			if (class_ids.length > 1 && class_ids[1] != null && class_ids[1].length > 0) {
+				class_name = class_ids[1];
+			}
+
+			ensure_index();
+
+			var cache_key = "%s\n%s".printf(instance, class_name ?? "");
+			unowned var cached = match_cache.lookup(cache_key);
+			if (cached != null) {
+				match_result.desktop_id = cached != "" ? cached : null;
+				return match_result;
+			}
+
+			debug(@"Matching WM_CLASS instance='$instance', class='$(class_name ?? "")'");
+
+			// Extract all possible name variants from the instance
+			string[] names = {};
+			add_unique(ref names, instance.down());
+			foreach (var variant in extract_name_variants(instance)) {
+				add_unique(ref names, variant.down());
+			}
+
+			uint best = uint.MAX;
+			foreach (var name in names) {
+				find_first(wm_class_index, name, ref best);
+				find_first(desktop_id_index, name, ref best);
+				find_first(reverse_dns_index, name, ref best);
+				find_first(snap_index, name, ref best);
+			}
+
+			if (class_name != null) {
+				var class_lower = class_name.down();
+				find_first(wm_class_index, class_lower, ref best);
+				find_first(desktop_id_index, class_lower, ref best);
+				find_first(reverse_dns_index, class_lower, ref best);
+			}
+
+			find_first(exec_index, instance, ref best);
+			if (instance.contains(" ")) {
+				// Check if e.g. "proton pass" is the executable proton-pass, or a
+				// malformed rev-dns name like "proton.mail"
+				find_first(exec_index, instance.replace(" ", "-"), ref best);
+				find_first(exec_index, instance.replace(" ", "."), ref best);
+			}
+
+			if (best != uint.MAX) {
+				match_result.desktop_id = indexed_ids[best];
+				debug(@"Matched instance='$instance' to $(match_result.desktop_id)");
+			} else {
+				debug(@"No match found for instance='$instance'");
+			}
+
+			match_cache.insert(cache_key, match_result.desktop_id ?? "");
+			return match_result;
+		}
+
+		/**
+		 * Lower `best` to the position of the first application with the
+		 * given name in an index, if that comes earlier.
+		 */
+		private void find_first(HashTable<string, uint> index, string name, ref uint best) {
+			if (index.contains(name)) {
+				uint position = index.lookup(name);
+				if (position < best) {
+					best = position;
+				}
+			}
+		}
+
+		/**
+		 * Add a name to an index, keeping the first application that has it.
+		 */
+		private void add_to_index(HashTable<string, uint> index, string name, uint position) {
+			if (!index.contains(name)) {
+				index.insert(name, position);
+			}
+		}
+
+		/**
+		 * Build the indexes of the installed applications, if they aren't
+		 * up to date.
+		 */
+		private void ensure_index() {
+			if (index_valid) {
+				return;
+			}
+
+			indexed_ids = {};
+			wm_class_index = new HashTable<string, uint>(str_hash, str_equal);
+			desktop_id_index = new HashTable<string, uint>(str_hash, str_equal);
+			reverse_dns_index = new HashTable<string, uint>(str_hash, str_equal);
+			snap_index = new HashTable<string, uint>(str_hash, str_equal);
+			exec_index = new HashTable<string, uint>(str_hash, str_equal);
+			match_cache = new HashTable<string, string>(str_hash, str_equal);
+
+			foreach (var app_info in AppInfo.get_all()) {
+				var desktop_info = app_info as DesktopAppInfo;
+				if (desktop_info == null) continue;
+
+				var desktop_id = desktop_info.get_id();
+				if (desktop_id == null) continue;
+
+				uint position = indexed_ids.length;
+				indexed_ids += desktop_id;
+
+				// StartupWMClass field in the desktop file
+				var wm_class = desktop_info.get_startup_wm_class();
+				if (wm_class != null && wm_class.length > 0) {
+					add_to_index(wm_class_index, wm_class.down(), position);
+				}
+
+				// Desktop file ID without the extension
+				var id_base = desktop_id.has_suffix(".desktop")
+					? desktop_id.substring(0, desktop_id.length - 8)
+					: desktop_id;
+				add_to_index(desktop_id_index, id_base.down(), position);
+
+				// Reverse-DNS naming (com.example.App)
+				if (id_base.contains(".")) {
+					var parts = id_base.split(".");
+					if (parts.length > 1) {
+						add_to_index(reverse_dns_index, parts[parts.length - 1].down(), position);
+					}
+				}
+
+				// Snap naming pattern (snap-name_app-name)
+				if (id_base.contains("_")) {
+					var snap_parts = id_base.split("_");
+					if (snap_parts.length >= 2) {
+						add_to_index(snap_index, snap_parts[0].down(), position);
+					}
+				}
+
+				// Executable of the desktop file
+				var executable = desktop_info.get_executable();
+				if (executable != null) {
+					add_to_index(exec_index, Path.get_basename(executable), position);
+				}
+			}
+
+			index_valid = true;
+			debug("Indexed %d applications for window matching", indexed_ids.length);
+		}
+
+		/**
+		 * Find the desktop ID that matches a window group.
+		 *
+		 * @param group The window group to match
+		 * @return MatchResult with the result of the match
+		 */
+		public MatchResult match_window_group(WindowGroup group) {
+			var window = group.get_first_window();
+			if (window == null) {
+				return new MatchResult();
+			}
+
+			return match_window(window);
+		}
+
+		/**
+		 * Extract all possible name variants from a WM_CLASS instance.
+		 *
+		 * Handles:
+		 * - Reverse-DNS: com.example.App → ["com.example.App", "App"]
+		 * - Java packages: org-gjt-sp-jedit-jEdit → ["org-gjt-sp-jedit-jEdit", "jEdit", "jedit", "org"]
+		 * - Dashed names: brave-browser → ["brave-browser", "browser", "brave"]
+		 *
+		 * @param instance The WM_CLASS instance string
+		 * @return Array of possible name variants
+		 */
+		private string[] extract_name_variants(string instance) {
+			var variants = new string[]{};
+
+			// Always include original
+			variants += instance;
+
+			// Handle dot-separated (reverse-DNS, Java packages)
+			if (instance.contains(".")) {
+				var parts = instance.split(".");
+				if (parts.length > 1) {
+					var last = parts[parts.length - 1];
+					add_unique(ref variants, last);
+				}
+			}
+
+			// Handle dash-separated
+			if (instance.contains("-")) {
+				var parts = instance.split("-");
+				if (parts.length > 1) {
+					add_unique(ref variants, parts[parts.length - 1]);
+					add_unique(ref variants, parts[0]);
+				}
+			}
+
+			// Add lowercase variants
+			foreach (var variant in variants.copy()) {
+				var lower = variant.down();
+				if (lower != variant) {
+					add_unique(ref variants, lower);
+				}
+			}
+
+			return variants;
+		}
+
+		/**
+		 * Add string to array if not already present.
+		 */
+		private void add_unique(ref string[] array, string value) {
+			foreach (var item in array) {
+				if (item == value) {
+					return;
+				}
+			}
+
+			var old_length = array.length;
+			array.resize(old_length + 1);
+			array[old_length] = value;
+		}
+	}
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of budgie-desktop
+ *
+ * Copyright Budgie Desktop Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+namespace Budgie.Windowing {
+	/**
+	 * A merged set of changes to the windows, collected over one frame.
+	 *
+	 * Windows that were opened and closed again within the same batch
+	 * are left out entirely, and state changes of a window are merged
+	 * into a single mask.
+	 */
+	public class WindowChanges : GLib.Object {
+		private GenericArray<Xfw.Window> added_windows;
+		private GenericArray<Xfw.Window> removed_windows;
+		private HashTable<Xfw.Window, uint> changed_windows;
+
+		/** Whether the active window changed. */
+		public bool active_window_changed { get; internal set; default = false; }
+
+		/** Whether the active workspace changed. */
+		public bool active_workspace_changed { get; internal set; default = false; }
+
+		construct {
+			added_windows = new GenericArray<Xfw.Window>();
+			removed_windows = new GenericArray<Xfw.Window>();
+			changed_windows = new HashTable<Xfw.Window, uint>(direct_hash, direct_equal);
+		}
+
+		/**
+		 * Get the windows that were opened.
+		 *
+		 * Returns: the opened windows, in the order they were opened
+		 */
+		public unowned GenericArray<Xfw.Window> get_added() {
+			return added_windows;
+		}
+
+		/**
+		 * Get the windows that were closed.
+		 *
+		 * Returns: the closed windows, in the order they were closed
+		 */
+		public unowned GenericArray<Xfw.Window> get_removed() {
+			return removed_windows;
+		}
+
+		/**
+		 * Get the windows whose state changed, excluding newly opened ones.
+		 *
+		 * Returns: the changed windows
+		 */
+		public List<weak Xfw.Window> get_changed() {
+			return changed_windows.get_keys();
+		}
+
+		/**
+		 * Get all of the state flags that changed for a window.
+		 *
+		 * Returns: the merged mask of changed state flags
+		 */
+		public Xfw.WindowState get_changed_mask(Xfw.Window window) {
+			return (Xfw.WindowState) changed_windows.lookup(window);
+		}
+
+		/**
+		 * Check if any windows were opened, closed, or changed.
+		 *
+		 * Returns: true if there are any window changes
+		 */
+		public bool has_window_changes() {
+			return added_windows.length > 0 || removed_windows.length > 0 || changed_windows.size() > 0;
+		}
+
+		internal void add_window(Xfw.Window window) {
+			added_windows.add(window);
+		}
+
+		internal void remove_window(Xfw.Window window) {
+			changed_windows.remove(window);
+
+			// Opened and closed within the same batch, so nobody needs to know
+			if (added_windows.remove(window)) {
+				return;
+			}
+
+			removed_windows.add(window);
+		}
+
+		internal void change_window(Xfw.Window window, Xfw.WindowState changed_mask) {
+			// New windows are reported with their current state anyway
+			if (added_windows.find(window)) {
+				return;
+			}
+
+			changed_windows.insert(window, changed_windows.lookup(window) | (uint) changed_mask);
+		}
+	}
+}
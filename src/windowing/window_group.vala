@@ -21,9 +21,17 @@ namespace Budgie.Windowing {
 		/** A copy of the application's ID. */
 		public string group_id { get; construct; }
 
+		/**
+		 * The desktop file of the application, as resolved by the shared
+		 * ApplicationMatcher when the group was created.
+		 */
 		public DesktopAppInfo? app_info { get; construct; default = null; }
 
-		private List<unowned Xfw.Window> windows;
+		// The windows in the order they were opened, and the link of each
+		// window in that queue so the ring can be walked in both directions
+		// without searching it.
+		private Queue<unowned Xfw.Window> windows;
+		private HashTable<unowned Xfw.Window, unowned List<unowned Xfw.Window>> window_links;
 
 		// The most recently focused window in the group. Deliberately not cleared
 		// when focus leaves the group, so it always holds the last window used.
@@ -62,7 +70,8 @@ namespace Budgie.Windowing {
 		}
 
 		construct {
-			windows = new List<unowned Xfw.Window>();
+			windows = new Queue<unowned Xfw.Window>();
+			window_links = new HashTable<unowned Xfw.Window, unowned List<unowned Xfw.Window>>(direct_hash, direct_equal);
 
 			application.icon_changed.connect(icon_changed);
 		}
@@ -79,6 +88,8 @@ namespace Budgie.Windowing {
 		 * Adds a window to this WindowGroup.
 		 */
 		public void add_window(Xfw.Window window) {
+			if (window_links.contains(window)) return;
+
 			debug(@"adding window to group '$(application.get_name())': $(window.get_name())");
 
 			window.state_changed.connect(state_changed);
@@ -91,7 +102,8 @@ namespace Budgie.Windowing {
 				active_window = window;
 			}
 
-			windows.append(window);
+			windows.push_tail(window);
+			window_links.insert(window, windows.peek_tail_link());
 			window_added(window);
 		}
 
@@ -100,6 +112,9 @@ namespace Budgie.Windowing {
 		 * has been closed.
 		 */
 		public void remove_window(Xfw.Window window) {
+			unowned var link = window_links.lookup(window);
+			if (link == null) return;
+
 			debug(@"removing window from group '$(application.get_name())': $(window.get_name())");
 
 			if (active_window == window) {
@@ -108,16 +123,26 @@ namespace Budgie.Windowing {
 				active_window = get_next_window(window, true);
 			}
 
+			window.state_changed.disconnect(state_changed);
+
 			window_removed(window);
-			windows.remove(window);
+			window_links.remove(window);
+			windows.delete_link(link);
 		}
 
 		/**
 		 * Get the desktop ID of this application.
 		 *
+		 * This is the ID of the matched desktop file if there is one, or
+		 * an ID based on the application name otherwise.
+		 *
 		 * Returns: the desktop ID of the application
 		 */
 		 public string get_desktop_id() {
+			if (app_info != null && app_info.get_id() != null) {
+				return app_info.get_id();
+			}
+
 			return "%s.desktop".printf(application.get_name());
 		}
 
@@ -146,9 +171,7 @@ namespace Budgie.Windowing {
 		 * Returns: the first opened window or null
 		 */
 		public Xfw.Window? get_first_window() {
-			unowned var first = windows.first();
-			if (first == null) return null;
-			return first.data;
+			return windows.peek_head();
 		}
 
 		/**
@@ -163,54 +186,59 @@ namespace Budgie.Windowing {
 		/**
 		 * Get the next window in the group relative to the given window.
 		 *
-		 * This works on a copy of the current window list in case we need
-		 * to reverse the list.
+		 * The windows form a ring in the order they were opened, so the
+		 * window after the last one is the first one again. If the given
+		 * window is null or not in this group, the first window (or the
+		 * last one, if reversed) is returned.
 		 *
-		 * Returns: The next (or technically previous, if reversed) window in the group
+		 * Returns: The next (or previous, if reversed) window in the group
 		 */
-		public unowned Xfw.Window get_next_window(Xfw.Window? window, bool reverse = false) {
-			// Make a copy of the window list to operate on
-			var copy = get_windows();
-
-			// Reverse the list if necessary
-			if (reverse) {
-				copy.reverse();
-			}
-
-			// If the window given to us is null, return the first window
-			if (window == null) {
-				return copy.first().data;
-			}
-
-			// If there is only one window in this group, just return it
-			if (windows.length() == 1) {
-				return window;
-			}
+		public unowned Xfw.Window? get_next_window(Xfw.Window? window, bool reverse = false) {
+			if (window != null && windows.length == 1) return window;
 
-			// Get and increment the index of the given window.
-			// This should get us the next window in the list.
-			// (Technically, the previous window, if we're in
-			// reverse mode.)
-			var i = copy.index(window);
+			unowned List<unowned Xfw.Window>? link = window != null ? window_links.lookup(window) : null;
 
-			i++;
-
-			// Make sure we don't go beyond the bounds of the list
-			if (i >= copy.length()) {
-				i = 0;
+			if (reverse) {
+				if (link != null && link.prev != null) return link.prev.data;
+				return windows.peek_tail();
 			}
 
-			// Return the window at the index
-			return copy.nth_data(i);
+			if (link != null && link.next != null) return link.next.data;
+			return windows.peek_head();
 		}
 
 		/**
-		 * Get the open windows in this group.
+		 * Get a copy of the open windows in this group.
+		 *
+		 * Use `peek_windows()` instead to iterate over the windows without
+		 * making a copy.
 		 *
 		 * Returns: a list of open windows
 		 */
 		public List<unowned Xfw.Window> get_windows() {
-			return windows.copy();
+			return windows.head.copy();
+		}
+
+		/**
+		 * Get the open windows in this group, in the order they were opened,
+		 * without copying them.
+		 *
+		 * The list belongs to the group and must not be modified, or kept
+		 * around after windows are added to or removed from the group.
+		 *
+		 * Returns: the list of open windows, or null if there are none
+		 */
+		public unowned List<unowned Xfw.Window>? peek_windows() {
+			return windows.head;
+		}
+
+		/**
+		 * Get the number of open windows in this group.
+		 *
+		 * Returns: the number of open windows
+		 */
+		public uint get_n_windows() {
+			return windows.length;
 		}
 
 		/**
@@ -220,7 +248,7 @@ namespace Budgie.Windowing {
 		 */
 		public bool has_window(Xfw.Window? window) {
 			if (window == null) return false;
-			return windows.find(window) != null;
+			return window_links.contains(window);
 		}
 
 		/**
@@ -230,9 +258,7 @@ namespace Budgie.Windowing {
 		 * Returns: true if there is a window on the workspace
 		 */
 		public bool has_window_on_workspace(Xfw.Workspace workspace) {
-			if (windows.is_empty()) return false;
-
-			foreach (unowned var window in windows) {
+			foreach (unowned var window in windows.head) {
 				var window_workspace = window.get_workspace();
 
 				if (window_workspace == null) continue;
@@ -249,8 +275,7 @@ namespace Budgie.Windowing {
 		 * Returns: true if there are open windows
 		 */
 		public bool has_windows() {
-			debug(@"window group '$(application.get_name()) has $(windows.length()) windows in it");
-			return windows.length() > 0;
+			return windows.length > 0;
 		}
 
 		/**
@@ -31,6 +31,16 @@ namespace Budgie.Windowing {
 	// Default filter for show desktop operations
 	public const WindowFilter SHOW_DESKTOP_FILTER = WindowFilter.SKIP_PAGER | WindowFilter.SKIP_TASKLIST;
 
+	/**
+	 * Per-window state for tracking maximized windows.
+	 */
+	private class TrackedWindow {
+		/* The monitors that this window is counted as maximized on */
+		public Gdk.Monitor[] maximized_on = {};
+		public ulong state_changed_id;
+		public ulong geometry_changed_id;
+	}
+
 	/**
 	 * This object keeps track of WindowGroups. It serves as the main part
 	 * of the Budgie windowing library.
@@ -56,6 +66,17 @@ namespace Budgie.Windowing {
 		private ulong active_window_changed_id;
 		private List<Xfw.Window> minimized_windows_by_show_desktop;
 
+		/* Changes collected since windows_changed was last emitted */
+		private WindowChanges? pending_changes = null;
+		private uint windows_changed_id = 0;
+
+		/* Every window on the screen, and the monitors it is counted as maximized on */
+		private HashTable<Xfw.Window, TrackedWindow> tracked_windows;
+		private bool tracking_maximized = false;
+
+		/* Number of maximized, non-minimized windows on each monitor */
+		private HashTable<Gdk.Monitor, uint> maximized_counts;
+
 		public bool has_windows { get; private set; }
 		public unowned List<Xfw.Window> windows { get { return screen.get_windows(); } }
 
@@ -110,6 +131,28 @@ namespace Budgie.Windowing {
 		 */
 		public signal void desktop_shown(bool showing);
 
+		/**
+		 * Emitted at most once per frame with all of the window changes
+		 * since the last emission.
+		 *
+		 * This is emitted right before GTK resizes and redraws, so
+		 * consumers that only need the end result of a burst of changes
+		 * can do their work once per frame instead of once per change.
+		 * Changes are only collected while something is connected.
+		 */
+		public signal void windows_changed(WindowChanges changes);
+
+		/**
+		 * Emitted when a monitor gets its first maximized window, or when
+		 * its last maximized window goes away.
+		 *
+		 * Only windows that are not minimized and not skipped by pagers
+		 * are counted, on every workspace. Windows are only tracked once
+		 * has_maximized_window() has been called, so this is not emitted
+		 * before then.
+		 */
+		public signal void maximized_state_changed(Gdk.Monitor monitor, bool has_maximized);
+
 		/**
 		 * Creates a new Windowing object. This is the entry point into
 		 * this library.
@@ -131,7 +174,11 @@ namespace Budgie.Windowing {
 				on_dbus_get
 			);
 
+			windows_changed_id = Signal.lookup("windows-changed", typeof(Windowing));
+
 			applications = new HashTable<Xfw.Application, WindowGroup>(direct_hash, direct_equal);
+			tracked_windows = new HashTable<Xfw.Window, TrackedWindow>(direct_hash, direct_equal);
+			maximized_counts = new HashTable<Gdk.Monitor, uint>(direct_hash, direct_equal);
 			fullscreen_windows = new List<Window>();
 
 			minimized_windows_by_show_desktop = new List<Xfw.Window>();
@@ -191,14 +238,40 @@ namespace Budgie.Windowing {
 			group.workspace_removed.connect(on_workspace_destroyed);
 		}
 
+		/**
+		 * Get the set of changes for the current frame, scheduling its
+		 * emission if this is the first change.
+		 *
+		 * Returns: the pending changes, or null if nothing is connected
+		 * to windows_changed and there is no point in collecting them
+		 */
+		private WindowChanges? get_pending_changes() {
+			if (pending_changes == null) {
+				if (!SignalHandler.has_handler_pending(this, windows_changed_id, 0, false)) return null;
+
+				pending_changes = new WindowChanges();
+				// Run before GTK's resize and redraw for the next frame
+				Idle.add_full(Priority.HIGH_IDLE + 10, flush_pending_changes);
+			}
+
+			return pending_changes;
+		}
+
+		private bool flush_pending_changes() {
+			var changes = (owned) pending_changes;
+
+			windows_changed(changes);
+			return Source.REMOVE;
+		}
+
 		private void on_active_window_changed(Window? old_window) {
 			var new_window = screen.get_active_window();
 			if (new_window == null) return;
 
-			foreach (var group in applications.get_values()) {
-				if (group.has_window(new_window)) {
-					group.set_active_window(new_window);
-				}
+			// Windows are grouped by their application, so the group can be looked up directly
+			var group = applications.lookup(new_window.get_application());
+			if (group != null && group.has_window(new_window)) {
+				group.set_active_window(new_window);
 			}
 
 			// Reset showing_desktop state when a new non-minimized window becomes active
@@ -209,10 +282,14 @@ namespace Budgie.Windowing {
 
 			last_active_window = old_window;
 
+			var changes = get_pending_changes();
+			if (changes != null) changes.active_window_changed = true;
 			active_window_changed(old_window, new_window);
 		}
 
 		private void on_active_workspace_changed(Workspace? previous_workspace) {
+			var changes = get_pending_changes();
+			if (changes != null) changes.active_workspace_changed = true;
 			active_workspace_changed(previous_workspace);
 		}
 
@@ -224,7 +301,112 @@ namespace Budgie.Windowing {
 			workspace_destroyed(workspace);
 		}
 
+		/**
+		 * Start tracking the maximized windows, if that hasn't been done yet.
+		 *
+		 * Every applet that lists windows has its own Windowing, but only the
+		 * panel manager cares about maximized windows, so the others never
+		 * watch the state and geometry of every window.
+		 */
+		private void ensure_maximized_tracking() {
+			if (tracking_maximized) return;
+
+			tracking_maximized = true;
+			screen.get_windows().foreach(track_window);
+		}
+
+		/**
+		 * Start counting a window towards the maximized windows of its monitors.
+		 */
+		private void track_window(Window window) {
+			if (!tracking_maximized || window in tracked_windows) return;
+
+			var tracked = new TrackedWindow();
+			tracked.state_changed_id = window.state_changed.connect(() => update_maximized(window));
+			tracked.geometry_changed_id = window.geometry_changed.connect(() => update_maximized(window));
+			tracked_windows.insert(window, tracked);
+
+			update_maximized(window);
+		}
+
+		/**
+		 * Stop counting a closed window.
+		 */
+		private void untrack_window(Window window) {
+			var tracked = tracked_windows.lookup(window);
+			if (tracked == null) return;
+
+			SignalHandler.disconnect(window, tracked.state_changed_id);
+			SignalHandler.disconnect(window, tracked.geometry_changed_id);
+			set_maximized_on(tracked, {});
+			tracked_windows.remove(window);
+		}
+
+		/**
+		 * Update the monitors that a window is counted as maximized on.
+		 */
+		private void update_maximized(Window window) {
+			var tracked = tracked_windows.lookup(window);
+			if (tracked == null) return;
+
+			Gdk.Monitor[] monitors = {};
+			if (!window.is_skip_pager() && window.is_maximized() && !window.is_minimized()) {
+				foreach (unowned var monitor in window.get_monitors()) {
+					unowned var gdk_monitor = monitor.get_gdk_monitor();
+					if (gdk_monitor != null) {
+						monitors += gdk_monitor;
+					}
+				}
+			}
+
+			set_maximized_on(tracked, monitors);
+		}
+
+		/**
+		 * Move a window's maximized count to a new set of monitors,
+		 * emitting maximized_state_changed for counts that cross zero.
+		 */
+		private void set_maximized_on(TrackedWindow tracked, Gdk.Monitor[] monitors) {
+			foreach (var monitor in tracked.maximized_on) {
+				if (monitor in monitors) continue;
+
+				uint count = maximized_counts.lookup(monitor) - 1;
+				if (count == 0) {
+					maximized_counts.remove(monitor);
+					maximized_state_changed(monitor, false);
+				} else {
+					maximized_counts.insert(monitor, count);
+				}
+			}
+
+			var previous = (owned) tracked.maximized_on;
+			tracked.maximized_on = monitors;
+
+			foreach (var monitor in tracked.maximized_on) {
+				if (monitor in previous) continue;
+
+				uint count = maximized_counts.lookup(monitor) + 1;
+				maximized_counts.insert(monitor, count);
+				if (count == 1) {
+					maximized_state_changed(monitor, true);
+				}
+			}
+		}
+
+		/**
+		 * Check whether a monitor has any maximized, non-minimized windows
+		 * on any workspace.
+		 *
+		 * Returns: true if the monitor has a maximized window
+		 */
+		public bool has_maximized_window(Gdk.Monitor monitor) {
+			ensure_maximized_tracking();
+			return monitor in maximized_counts;
+		}
+
 		private void on_window_added(Window window) {
+			track_window(window);
+
 			if (window.is_skip_tasklist()) return;
 
 			// Reset showing_desktop when new window is added
@@ -233,6 +415,8 @@ namespace Budgie.Windowing {
 				desktop_shown(is_show_desktop);
 			}
 
+			var changes = get_pending_changes();
+			if (changes != null) changes.add_window(window);
 			window_added(window);
 			has_windows = true;
 
@@ -249,8 +433,8 @@ namespace Budgie.Windowing {
 			// Not already open, create a new group
 			debug(@"creating new WindowGroup for application: $(application.get_name())");
 
-			unowned var app_id = application.get_class_id();
-			var app_info = new DesktopAppInfo(app_id + ".desktop");
+			// Resolve the desktop file once for the whole group
+			var app_info = ApplicationMatcher.get_default().match_application(application, window);
 			group = new WindowGroup(application, app_info);
 
 			group.add_window(window);
@@ -261,8 +445,11 @@ namespace Budgie.Windowing {
 
 		private void on_window_removed(Window window) {
 			has_windows = screen.get_windows().length() > 0;
+			untrack_window(window);
 
 			if (window.is_skip_tasklist()) return;
+			var changes = get_pending_changes();
+			if (changes != null) changes.remove_window(window);
 			window_removed(window);
 
 			var application = window.get_application();
@@ -287,6 +474,8 @@ namespace Budgie.Windowing {
 		}
 
 		private void on_window_state_changed(Window window, WindowState changed_mask, WindowState new_state) {
+			var changes = get_pending_changes();
+			if (changes != null) changes.change_window(window, changed_mask);
 			window_state_changed(window, changed_mask, new_state);
 
 			// Check if window was unminimized